@@ -12,6 +12,7 @@
 #include <ctime>
 #include <cstdlib>
 #include <ctime>
+#include <algorithm>
 
 
 unsigned int AudioParams::srate;
@@ -33,6 +34,7 @@ AudioBase::AudioBase(const char* dest, unsigned int nchnls,
 	mode = 0;
 	count = 0;
 	frameCount = 0;
+	ringPosition = 0;
 	errorCode = 0;
 	textFile = NULL;
 
@@ -66,6 +68,7 @@ AudioBase::AudioBase(const char* dest, unsigned int nchnls,
 			if (err == paNoError) {
 			  handle = (void *)stream;
 			  mode = AUDIO_REALTIME;
+			  deviceRing.allocate((bufferSize + vectorSize) * nchannels);
 			} else {
 			  //m_error = AULIB_RTSTREAM_ERROR;
 			  vectorSize = 0;
@@ -92,11 +95,11 @@ AudioBase::AudioBase(const char* dest, unsigned int nchnls,
 		info.samplerate = AudioParams::getSrate();
 		info.channels = AudioParams::getNchannels();
 		info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
-		buffer = new double[AudioParams::getBufferSize()];
 		SNDFILE *openFile = sf_open(destination ,SFM_WRITE, &info);
 		if(openFile != NULL) {
 			handle = (void *) openFile;
 			mode = AUDIO_SNDFILE;
+			fileRing.allocate(getFileChunk() + vectorSize * nchannels);
 		} else {
 			exception.setError(OPEN_FILE_TO_WRITE, destination, DEBUG_INFO);
 			exception.printErrorToConsole();
@@ -105,25 +108,49 @@ AudioBase::AudioBase(const char* dest, unsigned int nchnls,
 	}
 }
 
-int AudioBase::write(const double *signal){
+/**
+ * Interleaved samples per sound file write: the IO buffer size rounded down to whole frames.
+ */
+unsigned int AudioBase::getFileChunk() const {
+	return std::max(bufferSize / nchannels, 1u) * nchannels;
+}
 
-	if (mode == AUDIO_REALTIME && handle != NULL) {
+/**
+ * Output is gathered in mirrored rings. Each vector is written contiguously after the pending samples,
+ * and every full IO buffer is handed on as one contiguous span, so neither side checks for the end of
+ * the buffer sample by sample. `count` is the number of pending samples starting at `ringPosition`.
+ */
+void AudioBase::flushFile() {
+	const unsigned int chunk = getFileChunk();
+	while(count >= chunk) {
+		frameCount += sf_writef_double((SNDFILE*) handle, fileRing.data() + ringPosition, chunk / nchannels);
+		ringPosition = (ringPosition + chunk) & fileRing.getMask();
+		count -= chunk;
+	}
+}
 
-		PaError err;
-		int bsamples = bufferSize * nchannels;
-		float *buffer = new float(bufferSize * nchannels);
-		for (unsigned int i = 0; i < vectorSize; i++) {
-		  buffer[count++] = signal[i];
-		  if (count == bsamples) {
-			err = Pa_WriteStream((PaStream *)handle, buffer, bufferSize);
-			if (err == paNoError) {
-			  frameCount += count / nchannels;
-			}
-			count = 0;
-		  }
-		}
+void AudioBase::flushDevice() {
+	const unsigned int chunk = bufferSize * nchannels;
+	while(count >= chunk) {
+		PaError err = Pa_WriteStream((PaStream *)handle, deviceRing.data() + ringPosition, bufferSize);
+		if (err == paNoError)
+			frameCount += bufferSize;
+		ringPosition = (ringPosition + chunk) & deviceRing.getMask();
+		count -= chunk;
+	}
+}
 
+int AudioBase::write(const double *signal){
 
+	if (mode == AUDIO_REALTIME && handle != NULL) {
+		unsigned int start = (ringPosition + count) & deviceRing.getMask();
+		float *out = deviceRing.data() + start;
+		for (unsigned int i = 0; i < vectorSize; i++)
+			for (unsigned int j = 0; j < nchannels; j++)
+				*out++ = (float)signal[i];
+		deviceRing.commit(start, vectorSize * nchannels);
+		count += vectorSize * nchannels;
+		flushDevice();
 	} else if (mode == AUDIO_STDOUT) {
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++){
 			fprintf(textFile, "%f\n", signal[i]);
@@ -131,14 +158,14 @@ int AudioBase::write(const double *signal){
 		}
 		frameCount += count;
 	} else if(mode == AUDIO_SNDFILE && handle != NULL) {
-		for(unsigned int i = 0; i < AudioParams::vectorSize; i++) {
+		unsigned int start = (ringPosition + count) & fileRing.getMask();
+		double *out = fileRing.data() + start;
+		for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 			for(unsigned int j = 0; j < AudioParams::nchannels; j++)
-				buffer[count++] = signal[i];
-			if(count >= AudioParams::bufferSize) {
-				frameCount += sf_writef_double((SNDFILE*) handle, buffer, AudioParams::bufferSize/AudioParams::nchannels);
-				count = 0;
-			}
-		}
+				*out++ = signal[i];
+		fileRing.commit(start, vectorSize * nchannels);
+		count += vectorSize * nchannels;
+		flushFile();
 	} else
 		return 0;
 
@@ -153,20 +180,15 @@ int AudioBase::writeStereo(const double *left, const double *right){
 		exit(exception.getErrorNumber());
 	}
 	if (mode == AUDIO_REALTIME && handle != NULL) {
-		/*PaError err;
-		int bsamples = bufferSize * nchannels;
-		float *buffer = new float(bufferSize * nchannels);
+		unsigned int start = (ringPosition + count) & deviceRing.getMask();
+		float *out = deviceRing.data() + start;
 		for (unsigned int i = 0; i < vectorSize; i++) {
-		  buffer[count++] = signal[i];
-		  if (count == bsamples) {
-			err = Pa_WriteStream((PaStream *)handle, buffer, bufferSize);
-			if (err == paNoError) {
-			  frameCount += count / nchannels;
-			}
-			count = 0;
-		  }
-		}*/
-
+			*out++ = (float)left[i];
+			*out++ = (float)right[i];
+		}
+		deviceRing.commit(start, 2 * vectorSize);
+		count += 2 * vectorSize;
+		flushDevice();
 	} else if (mode == AUDIO_STDOUT) {
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++){
 			fprintf(textFile, "%f\t%f\n", left[i], right[i]);
@@ -174,14 +196,15 @@ int AudioBase::writeStereo(const double *left, const double *right){
 		}
 		frameCount += count;
 	} else if(mode == AUDIO_SNDFILE && handle != NULL) {
+		unsigned int start = (ringPosition + count) & fileRing.getMask();
+		double *out = fileRing.data() + start;
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++) {
-			buffer[count++] = left[i];
-			buffer[count++] = right[i];
-			if(count >= AudioBuffer::bufferSize) {
-				frameCount += sf_writef_double((SNDFILE*) handle, buffer, AudioParams::bufferSize/AudioParams::nchannels);
-				count = 0;
-			}
+			*out++ = left[i];
+			*out++ = right[i];
 		}
+		fileRing.commit(start, 2 * vectorSize);
+		count += 2 * vectorSize;
+		flushFile();
 	} else
 		return 0;
 
@@ -196,11 +219,10 @@ AudioBase::~AudioBase(){
 		  fclose(textFile);
   } else if (mode == AUDIO_SNDFILE && handle != NULL){
 	  if (count != 0) {
-		  sf_writef_double((SNDFILE*) handle, buffer, count);
+		  sf_writef_double((SNDFILE*) handle, fileRing.data() + ringPosition, count / nchannels);
 		  count = 0;
 	  }
 	  sf_close((SNDFILE *) handle);
-	  delete[] buffer;
   }
   std::cout << "Execution time (sec): " << (double)(clock() - startTime)/CLOCKS_PER_SEC << std::endl;
 }
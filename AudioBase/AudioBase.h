@@ -12,6 +12,7 @@
 #include <vector>
 #include <ctime>
 #include "AudioException.h"
+#include "MirrorRing.h"
 
 /**
  *	Default vector size for signals (block size/ksmps/control buffer)
@@ -107,8 +108,18 @@ class AudioBuffer : public AudioParams, public AudioException {
 protected:
 	std::vector<double> vector;
 	AudioException exception;
+	bool silent;
+
+	/**
+	 * Vector of `buffer` for writing, for modules that fill output buffers they hold besides their own
+	 * vector (a per-channel or per-group output). Clears the silent mark of `buffer`.
+	 */
+	static double *writableData(AudioBuffer &buffer) {
+		buffer.silent = false;
+		return &buffer.vector[0];
+	}
 public:
-	AudioBuffer() : vector(AudioParams::vectorSize, 0.0) {}
+	AudioBuffer() : vector(AudioParams::vectorSize, 0.0), silent(false) {}
 
 	virtual ~AudioBuffer(){
 		vector.clear();
@@ -128,6 +139,25 @@ public:
 		for(unsigned int i = 0; i < getVectorSize(); i++){
 			vector[i] = signal[i];
 		}
+		silent = signal.silent;
+	}
+
+	/**
+	 * True if the vector is known to hold only zeros. Generators set this when their output is silent,
+	 * and stateful modules set it while they are idle, so that modules further down the chain can skip
+	 * their work. False does not mean the vector holds sound, only that nothing is known about it.
+	 */
+	bool isSilent() const { return silent; }
+
+	/**
+	 * Zeros the vector and marks it as silent. Does nothing if it is already marked.
+	 */
+	void setSilence() {
+		if(silent)
+			return;
+		for(unsigned int i = 0; i < getVectorSize(); i++)
+			vector[i] = 0.0;
+		silent = true;
 	}
 
 // + Operator overload
@@ -163,24 +193,29 @@ public:
 	}
 
 	virtual AudioBuffer operator+(const AudioBuffer &obj) {
-		return *this + obj.vector;
+		AudioBuffer temp = *this + obj.vector;
+		temp.silent = silent && obj.silent;
+		return temp;
 	}
 
 // += Operator Overload
 
 	virtual AudioBuffer &operator+=(const double scalar) {
+		silent = false;
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 			vector[i] += scalar;
 		return *this;
 	}
 
 	virtual AudioBuffer &operator+=(const double *array) {
+		silent = false;
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 			vector[i] += array[i];
 		return *this;
 	}
 
 	virtual AudioBuffer &operator+=(const std::vector<double> vect) {
+		silent = false;
 		if(this->vectorSize == vect.size()) {
 			for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 				vector[i] += vect[i];
@@ -189,7 +224,10 @@ public:
 	}
 
 	virtual AudioBuffer operator+=(const AudioBuffer &obj) {
-		return *this += obj.vector;
+		bool both = silent && obj.silent;
+		*this += obj.vector;
+		silent = both;
+		return *this;
 	}
 
 // - Operator overload
@@ -218,24 +256,29 @@ public:
 	}
 
 	virtual AudioBuffer operator-(const AudioBuffer &obj) {
-		return *this - obj.vector;
+		AudioBuffer temp = *this - obj.vector;
+		temp.silent = silent && obj.silent;
+		return temp;
 	}
 
 // -= Operator Overload
 
 	virtual AudioBuffer &operator-=(const double scalar) {
+		silent = false;
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 			vector[i] -= scalar;
 		return *this;
 	}
 
 	virtual AudioBuffer &operator-=(const double *array) {
+		silent = false;
 		for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 			vector[i] -= array[i];
 		return *this;
 	}
 
 	virtual AudioBuffer &operator-=(const std::vector<double> vect) {
+		silent = false;
 		if(this->vectorSize == vect.size()) {
 			for(unsigned int i = 0; i < AudioParams::vectorSize; i++)
 				vector[i] -= vect[i];
@@ -244,7 +287,10 @@ public:
 	}
 
 	virtual AudioBuffer operator-=(const AudioBuffer &obj) {
-		return *this -= obj.vector;
+		bool both = silent && obj.silent;
+		*this -= obj.vector;
+		silent = both;
+		return *this;
 	}
 
 // * Operator Overload
@@ -280,7 +326,9 @@ public:
 	}
 
 	virtual AudioBuffer operator*(const AudioBuffer &obj) {
-		return *this * obj.vector;
+		AudioBuffer temp = *this * obj.vector;
+		temp.silent = silent || obj.silent;
+		return temp;
 	}
 
 // *= Operator Overload
@@ -306,7 +354,10 @@ public:
 	}
 
 	virtual AudioBuffer &operator*=(const AudioBuffer &obj) {
-		return *this *= obj.vector;
+		bool either = silent || obj.silent;
+		*this *= obj.vector;
+		silent = either;
+		return *this;
 	}
 
 // / Operator Overload
@@ -393,11 +444,17 @@ private:
 	unsigned int mode;
 	unsigned int count;
 	int frameCount;
-	double *buffer;
+	MirrorRing<double> fileRing;
+	MirrorRing<float> deviceRing;
+	unsigned int ringPosition;
 	void *handle;
 	FILE *textFile;
 	clock_t startTime;
 
+	unsigned int getFileChunk() const;
+	void flushFile();
+	void flushDevice();
+
 protected:
 	int errorCode;
 
@@ -0,0 +1,69 @@
+/*
+ * Denormal.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef DENORMAL_H_
+#define DENORMAL_H_
+
+#include <cmath>
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define AUDIOBASE_MXCSR 1
+#endif
+
+/**
+ * Magnitude below which recursive DSP state is flushed to zero. Far below audibility, and far above the
+ * subnormal range where floating point arithmetic becomes slow on many processors.
+ */
+const double def_denormal = 1e-30;
+
+/**
+ * Returns `x`, or zero if it is smaller in magnitude than `def_denormal`. Used on feedback paths so that
+ * decaying tails reach exact zero instead of drifting into subnormal numbers.
+ */
+inline double flushDenormal(double x) {
+	return fabs(x) < def_denormal ? 0.0 : x;
+}
+
+/**
+ * Scoped flush-to-zero mode for the calling thread. While an object of this class exists, subnormal
+ * results are flushed to zero and subnormal inputs are treated as zero (FTZ and DAZ on x86, FZ on
+ * AArch64). The previous mode is restored when it is destroyed. Create one at the top of the audio
+ * callback or processing loop. On other platforms it does nothing, and the per-module flushing still
+ * applies.
+ */
+class DenormalGuard {
+protected:
+	unsigned long long saved;
+
+public:
+	DenormalGuard() : saved(0) {
+#if defined(AUDIOBASE_MXCSR)
+		saved = _mm_getcsr();
+		// FTZ is bit 15, DAZ is bit 6.
+		_mm_setcsr((unsigned int) saved | 0x8040);
+#elif defined(__aarch64__)
+		unsigned long long fpcr;
+		__asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+		saved = fpcr;
+		// FZ is bit 24.
+		__asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1ULL << 24)));
+#endif
+	}
+
+	~DenormalGuard() {
+#if defined(AUDIOBASE_MXCSR)
+		_mm_setcsr((unsigned int) saved);
+#elif defined(__aarch64__)
+		__asm__ __volatile__("msr fpcr, %0" : : "r"(saved));
+#endif
+	}
+
+	DenormalGuard(const DenormalGuard &) = delete;
+	DenormalGuard &operator=(const DenormalGuard &) = delete;
+};
+
+#endif /* DENORMAL_H_ */
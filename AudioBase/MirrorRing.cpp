@@ -0,0 +1,108 @@
+/*
+ * MirrorRing.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "MirrorRing.h"
+#include <algorithm>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+size_t MirrorMemory::getPageSize() {
+#if defined(__linux__)
+	static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	return pageSize;
+#else
+	return 4096;
+#endif
+}
+
+/**
+ * Reserves twice `size` of address space, then maps an anonymous memory file over both halves. The
+ * file is closed straight away; the mappings keep the pages alive.
+ */
+bool MirrorMemory::map(size_t size) {
+#if defined(__linux__) && defined(SYS_memfd_create)
+	int fd = (int)syscall(SYS_memfd_create, "mirror-ring", 0);
+	if(fd < 0)
+		return false;
+	if(ftruncate(fd, size) != 0) {
+		close(fd);
+		return false;
+	}
+	void *region = mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(region == MAP_FAILED) {
+		close(fd);
+		return false;
+	}
+	char *first = (char *)region;
+	void *lower = mmap(first, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+	void *upper = mmap(first + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+	close(fd);
+	if(lower != first || upper != first + size) {
+		munmap(region, 2 * size);
+		return false;
+	}
+	base = first;
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * New memory is zero in both cases: memory files start empty, and the heap copy is value-initialized.
+ */
+void MirrorMemory::allocate(size_t size) {
+	release();
+	mapped = map(size);
+	if(!mapped)
+		base = new char[2 * size]();
+	bytes = size;
+}
+
+void MirrorMemory::release() {
+	if(base == NULL)
+		return;
+#if defined(__linux__)
+	if(mapped)
+		munmap(base, 2 * bytes);
+	else
+		delete[] base;
+#else
+	delete[] base;
+#endif
+	base = NULL;
+	bytes = 0;
+	mapped = false;
+}
+
+/**
+ * Removing the pages of a memory file frees them; both halves then read as zero.
+ */
+void MirrorMemory::discard() {
+#if defined(__linux__) && defined(MADV_REMOVE)
+	if(mapped && madvise(base, bytes, MADV_REMOVE) == 0)
+		return;
+#endif
+	memset(base, 0, mapped ? bytes : 2 * bytes);
+}
+
+/**
+ * Copies the bytes written at `offset` to their twin in the other half. A range that crosses the middle
+ * is split: the part in the first half is copied up, the part in the second half down.
+ */
+void MirrorMemory::mirror(size_t offset, size_t count) {
+	size_t end = offset + count;
+	if(offset < bytes)
+		memcpy(base + offset + bytes, base + offset, std::min(end, bytes) - offset);
+	if(end > bytes) {
+		size_t from = std::max(offset, bytes);
+		memcpy(base + from - bytes, base + from, end - from);
+	}
+}
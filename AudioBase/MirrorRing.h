@@ -0,0 +1,146 @@
+/*
+ * MirrorRing.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef MIRRORRING_H_
+#define MIRRORRING_H_
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * Untyped storage for MirrorRing. Holds `2 * bytes` of addressable memory whose second half mirrors the
+ * first. Where the system allows it (Linux), both halves are mappings of the same physical pages, so a
+ * write through either half is visible through the other. Otherwise the memory is ordinary heap memory
+ * and mirror() copies written ranges across.
+ */
+class MirrorMemory {
+protected:
+	char *base;
+	size_t bytes;
+	bool mapped;
+
+	MirrorMemory() : base(NULL), bytes(0), mapped(false) {}
+	~MirrorMemory() { release(); }
+
+	bool map(size_t size);
+	void allocate(size_t size);
+	void release();
+	void discard();
+	void mirror(size_t offset, size_t count);
+
+public:
+	/**
+	 * Size of a memory page. Both halves of a mapped ring are whole pages.
+	 */
+	static size_t getPageSize();
+};
+
+/**
+ * Ring buffer of a power of two length in which every window of up to `length` elements, starting
+ * anywhere in the ring, is contiguous. Element `length + i` is the same sample as element `i`, so a
+ * reader or writer computes its start position with the mask once and then walks straight through the
+ * window without wrapping.
+ *
+ * After writing through data(), call commit() with the range written. Mapped rings need nothing, so
+ * commit() does no work there; rings in ordinary memory copy the range into the other half.
+ *
+ * The length is rounded up to whole pages, at least 4096 bytes on most systems. allocate(), release()
+ * and discard() make system calls and must not be called from the audio callback; allocate rings when
+ * their owner is constructed. A mapped ring takes physical memory only as its pages are first written.
+ */
+template<typename T>
+class MirrorRing : protected MirrorMemory {
+protected:
+	unsigned int length;
+
+public:
+	MirrorRing() : length(0) {}
+
+	MirrorRing(const MirrorRing &other) : MirrorMemory(), length(0) { *this = other; }
+
+	MirrorRing &operator=(const MirrorRing &other) {
+		if(this == &other)
+			return *this;
+		allocate(other.length);
+		if(length) {
+			memcpy(data(), other.data(), length * sizeof(T));
+			commit(0, length);
+		}
+		return *this;
+	}
+
+	/**
+	 * Shortest ring holding at least `minimum` elements.
+	 */
+	static unsigned int getRingLength(unsigned int minimum) {
+		unsigned int ringLength = 1;
+		while(ringLength < minimum || ringLength * sizeof(T) < getPageSize())
+			ringLength <<= 1;
+		return ringLength;
+	}
+
+	/**
+	 * Replaces the contents with a zeroed ring of at least `minimum` elements. A minimum of zero releases
+	 * the memory.
+	 */
+	void allocate(unsigned int minimum) {
+		if(minimum == 0) {
+			release();
+			return;
+		}
+		length = getRingLength(minimum);
+		MirrorMemory::allocate(length * sizeof(T));
+	}
+
+	void release() {
+		MirrorMemory::release();
+		length = 0;
+	}
+
+	/**
+	 * Zeros the ring and gives its pages back to the system, keeping the mapping. Pages are committed
+	 * again as they are written. Rings in ordinary memory are only cleared.
+	 */
+	void discard() {
+		if(length)
+			MirrorMemory::discard();
+	}
+
+	void clear() {
+		if(length) {
+			memset(base, 0, length * sizeof(T));
+			commit(0, length);
+		}
+	}
+
+	/**
+	 * Publishes `count` elements written at data() + `position` to the other half of the ring.
+	 * `position + count` must not exceed 2 * length.
+	 */
+	void commit(unsigned int position, unsigned int count) {
+		if(!mapped)
+			mirror(position * sizeof(T), count * sizeof(T));
+	}
+
+	T *data() { return (T *)base; }
+
+	const T *data() const { return (const T *)base; }
+
+	unsigned int getLength() const { return length; }
+
+	/**
+	 * Mask that wraps positions into the first half. Zero while nothing is allocated.
+	 */
+	unsigned int getMask() const { return length ? length - 1 : 0; }
+
+	/**
+	 * True if the two halves share physical memory.
+	 */
+	bool isMapped() const { return mapped; }
+};
+
+#endif /* MIRRORRING_H_ */
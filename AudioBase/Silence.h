@@ -0,0 +1,75 @@
+/*
+ * Silence.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef SILENCE_H_
+#define SILENCE_H_
+
+#include "AudioBase.h"
+#include <cmath>
+
+/**
+ * Level (-120 dB) below which the tail of a stateful module is treated as silence.
+ */
+const double def_silence = 1e-6;
+
+/**
+ * Filter memory magnitude below which a filter with silent input is treated as silent. Well below
+ * `def_silence`, since a resonant filter can ring much louder than the values held in its memory.
+ */
+const double def_silentstate = 1e-9;
+
+/**
+ * Tail length of a module whose output never dies away, for example a delay with feedback of 1.
+ */
+const unsigned long def_endlesstail = ~0UL;
+
+/**
+ * Number of samples for a recirculating loop of `loopSamples` with gain `gain` to decay from full scale
+ * to `def_silence`, counting the first pass through the loop.
+ */
+inline unsigned long loopTail(double loopSamples, double gain) {
+	gain = fabs(gain);
+	if(gain >= 1.0)
+		return def_endlesstail;
+	double passes = gain > 0.0 ? ceil(log(def_silence) / log(gain)) : 0.0;
+	return (unsigned long) ceil(loopSamples * (passes + 1));
+}
+
+/**
+ * Decides when a stateful module can stop processing. Each block, the module passes in whether its input
+ * is marked silent and its current tail length in samples. Once the input has been silent for longer
+ * than the tail, update() returns true and the module can clear its state and output silence, without
+ * processing, until a block with input that is not silent arrives.
+ */
+class SilenceTracker {
+protected:
+	unsigned long quiet;
+
+public:
+	SilenceTracker() : quiet(0) {}
+
+	/**
+	 * @return True if the current block can be skipped.
+	 */
+	bool update(bool inputSilent, unsigned long tail) {
+		if(!inputSilent) {
+			quiet = 0;
+			return false;
+		}
+		if(quiet >= tail)
+			return true;
+		quiet += AudioParams::getVectorSize();
+		return false;
+	}
+
+	/**
+	 * Forgets any silence seen so far, for example after the module's parameters change.
+	 */
+	void reset() { quiet = 0; }
+};
+
+#endif /* SILENCE_H_ */
@@ -0,0 +1,120 @@
+/*
+ * CombBank.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "CombBank.h"
+#include "Denormal.h"
+#include <cstdlib>
+#include <algorithm>
+
+CombBank::CombBank(const std::vector<double> &delayTimes, unsigned int outputs, DELAY_TIME_METRIC metric) :
+		combs(delayTimes.size()), outputs(outputs), lengths(delayTimes.size()), feedback(delayTimes.size(), 0.0),
+		delayLines(delayTimes.size()), outputBuffers(outputs), shortest(0), writePosition(0) {
+	if(outputs == 0 || combs % outputs != 0) {
+		exception.setError(SIZE_MISMATCH, "Comb count is not a multiple of the output count", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+
+	shortest = combs > 0 ? ~0u : 0;
+	for(unsigned int c = 0; c < combs; c++) {
+		double samples = delayTimes[c];
+		if(metric == SECONDS)
+			samples *= getSrate();
+		else if(metric == MILLIS)
+			samples *= getSrate() / 1000.0;
+		lengths[c] = std::max((unsigned int) samples, 1u);
+		shortest = std::min(shortest, lengths[c]);
+		// Room for the delay and for a whole block of reads or writes anywhere in the mirrored ring.
+		delayLines[c].allocate(std::max(lengths[c] + 1, getVectorSize()));
+	}
+}
+
+void CombBank::setFeedback(unsigned int comb, double feedback) {
+	if(comb < combs)
+		this->feedback[comb] = feedback;
+}
+
+void CombBank::setDecay(double decayTime) {
+	for(unsigned int c = 0; c < combs; c++)
+		feedback[c] = Delay::getFeedbackFromDecay(decayTime, lengths[c] / (double) getSrate());
+}
+
+/**
+ * Every comb is at least a block long, so nothing written in this block is read back. The read and the
+ * write window of each comb are contiguous in its mirrored ring.
+ */
+void CombBank::processBlock(const double *in) {
+	const unsigned int vsize = getVectorSize();
+	const unsigned int group = combs / outputs;
+	for(unsigned int c = 0; c < combs; c++) {
+		MirrorRing<double> &line = delayLines[c];
+		const unsigned int mask = line.getMask();
+		const unsigned int write = writePosition & mask;
+		const double *src = line.data() + ((writePosition - lengths[c]) & mask);
+		double *dest = line.data() + write;
+		double *out = writableData(outputBuffers[c / group]);
+		const double g = feedback[c];
+		for(unsigned int i = 0; i < vsize; i++) {
+			double y = src[i];
+			dest[i] = flushDenormal(in[i] + y * g);
+			out[i] += y;
+		}
+		line.commit(write, vsize);
+	}
+}
+
+void CombBank::processSamples(const double *in) {
+	const unsigned int vsize = getVectorSize();
+	const unsigned int group = combs / outputs;
+	for(unsigned int i = 0; i < vsize; i++) {
+		for(unsigned int c = 0; c < combs; c++) {
+			MirrorRing<double> &line = delayLines[c];
+			const unsigned int mask = line.getMask();
+			const unsigned int write = (writePosition + i) & mask;
+			double y = line.data()[(write - lengths[c]) & mask];
+			line.data()[write] = flushDenormal(in[i] + y * feedback[c]);
+			line.commit(write, 1);
+			writableData(outputBuffers[c / group])[i] += y;
+		}
+	}
+}
+
+unsigned long CombBank::getTailLength() const {
+	unsigned long tail = 0;
+	for(unsigned int c = 0; c < combs; c++)
+		tail = std::max(tail, loopTail(lengths[c], feedback[c]));
+	return tail;
+}
+
+const AudioBuffer &CombBank::process(const AudioBuffer &signal) {
+	const unsigned int vsize = getVectorSize();
+	if(silence.update(signal.isSilent(), getTailLength())) {
+		if(!silent) {
+			for(unsigned int o = 0; o < outputs; o++)
+				outputBuffers[o].setSilence();
+			setSilence();
+		}
+		return *this;
+	}
+	silent = false;
+	for(unsigned int o = 0; o < outputs; o++)
+		std::fill(writableData(outputBuffers[o]), writableData(outputBuffers[o]) + vsize, 0.0);
+
+	if(shortest >= vsize)
+		processBlock(signal.getVector());
+	else
+		processSamples(signal.getVector());
+	writePosition += vsize;
+
+	std::fill(vector.begin(), vector.end(), 0.0);
+	for(unsigned int o = 0; o < outputs; o++) {
+		const double *out = outputBuffers[o].getVector();
+		for(unsigned int i = 0; i < vsize; i++)
+			vector[i] += out[i];
+	}
+	return *this;
+}
@@ -0,0 +1,88 @@
+/*
+ * CombBank.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef COMBBANK_H_
+#define COMBBANK_H_
+
+#include "AudioBase.h"
+#include "Delay.h"
+#include "MirrorRing.h"
+#include "Silence.h"
+#include <vector>
+
+/**
+ * Bank of parallel feedback combs sharing one input, for example the comb section of a Schroeder reverb.
+ * Each comb behaves exactly like a Delay with a constant delay time and feedback. The combs are processed in
+ * a single call that writes straight into the output sums, without per-comb virtual calls or temporary
+ * buffers.
+ *
+ * Each comb has its own MirrorRing, sized from that comb's delay (rounded up to a power of two and to
+ * whole pages). The rings are mapped in the constructor and take physical memory only as the combs first
+ * write to them. When every comb is at least a block long, each comb's read, write and sum for the block
+ * are one straight loop over contiguous samples. Shorter combs are processed a sample at a time, all combs
+ * together.
+ *
+ * The combs can be split into consecutive groups with one output each (for example the left and right
+ * combs of a stereo reverb). getOutput() gives each group's sum, and the vector holds the sum of all
+ * groups.
+ */
+class CombBank : public AudioBuffer {
+protected:
+	unsigned int combs;
+	unsigned int outputs;
+	std::vector<unsigned int> lengths;
+	std::vector<double> feedback;
+	std::vector<MirrorRing<double> > delayLines;
+	std::vector<AudioBuffer> outputBuffers;
+	unsigned int shortest;
+	unsigned int writePosition;
+	SilenceTracker silence;
+
+	void processBlock(const double *in);
+	void processSamples(const double *in);
+
+public:
+	/**
+	 * @param delayTimes Delay time of each comb. The number of combs must be a multiple of `outputs`.
+	 * @param outputs Number of output groups.
+	 * @param metric Unit of the delay times.
+	 */
+	CombBank(const std::vector<double> &delayTimes, unsigned int outputs = 1, DELAY_TIME_METRIC metric = SECONDS);
+
+	virtual ~CombBank() {}
+
+	void setFeedback(unsigned int comb, double feedback);
+
+	/**
+	 * Sets the feedback of every comb so that each decays by 60 dB in `decayTime` seconds.
+	 */
+	void setDecay(double decayTime);
+
+	unsigned int getCombs() const { return combs; }
+
+	/**
+	 * Delay of a comb in samples.
+	 */
+	unsigned int getLength(unsigned int comb) const { return lengths[comb]; }
+
+	/**
+	 * Tail of the slowest comb in samples. Processing stops once the input has been silent this long, as
+	 * in Delay.
+	 */
+	unsigned long getTailLength() const;
+
+	/**
+	 * Sum of the combs of one output group from the last process() call.
+	 */
+	const AudioBuffer &getOutput(unsigned int output) const { return outputBuffers[output]; }
+
+	const AudioBuffer &process(const AudioBuffer &signal);
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+#endif /* COMBBANK_H_ */
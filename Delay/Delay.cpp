@@ -6,7 +6,10 @@
  */
 #include "AudioBase.h"
 #include "Delay.h"
+#include "Denormal.h"
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 
 void Delay::setSampleWise(double &number) {
 	switch(metric) {
@@ -42,22 +45,163 @@ void Delay::checkModulation(int index) {
 	}
 }*/
 
-void Delay::dsp() {
-	double x1, x2, y1, y2, x;
-	for(unsigned int i = 0; i < getVectorSize(); i++) {
+/**
+ * Interpolated read of the sample `delay` samples before the write position plus `offset`. The Thiran
+ * allpass advances its state, so reads must be made in sample order.
+ */
+double Delay::readDelayed(double delay, unsigned int offset) {
+	const double *buf = delayBuffer.data();
+	if(interpolation == DELAY_THIRAN) {
+		long whole = std::max((long)floor(delay - 0.5), 0L);
+		double a = FracDelayTable::thiran(delay - whole);
+		unsigned int index = (writePosition + offset - whole - 1) & mask;
+		allpassState = a * (buf[index + 1] - allpassState) + buf[index];
+		return allpassState;
+	}
+
+	long whole = (long)ceil(delay);
+	double frac = whole - delay;
+	if(interpolation == DELAY_LINEAR) {
+		unsigned int index = (writePosition + offset - whole) & mask;
+		return buf[index] + frac * (buf[index + 1] - buf[index]);
+	}
+
+	int first = fracTable->getFirst();
+	const double *x = buf + ((writePosition + offset - whole + first) & mask);
+	return fracTable->interpolate(x - first, frac);
+}
+
+/**
+ * Longest run of samples that can be read at `delay` before any of them depends on a sample written in
+ * the same run.
+ */
+int Delay::runLimit(double delay) const {
+	if(interpolation == DELAY_THIRAN)
+		return (int)floor(delay - 0.5);
+	return (int)floor(delay) - fracTable->getReach() + 1;
+}
+
+/**
+ * Constant delay and feedback are processed in runs no longer than runLimit(), so a run never reads
+ * what it writes. The ring is mirrored, so every run is contiguous wherever it starts. Each run is a
+ * block copy (integer delay) or a straight interpolation loop with coefficients fixed for the block,
+ * followed by the write loop.
+ */
+void Delay::dspConstant() {
+	double *buf = delayBuffer.data();
+	const unsigned int vsize = getVectorSize();
+	const unsigned int longest = runLimit(delayTime);
+	const bool thiran = interpolation == DELAY_THIRAN;
+	const long whole = thiran ? (long)floor(delayTime - 0.5) : (long)ceil(delayTime);
+	const double frac = whole - delayTime;
+	const int first = thiran ? -1 : fracTable->getFirst();
+	const unsigned int taps = fracTable->getTaps();
+	const double a = thiran ? FracDelayTable::thiran(delayTime - whole) : 0.0;
+	double coeffs[8];
+	if(!thiran)
+		fracTable->getCoefficients(frac, coeffs);
+
+	unsigned int i = 0;
+	while(i < vsize) {
+		// Start at the earliest tap so that src[first] is inside the ring.
+		unsigned int start = (writePosition - whole + first) & mask;
+		unsigned int n = std::min(vsize - i, longest);
+
+		double *out = &vector[i];
+		const double *src = buf + start - first;
+		if(thiran) {
+			double state = allpassState;
+			for(unsigned int k = 0; k < n; k++) {
+				state = a * (src[k] - state) + src[(int)k - 1];
+				out[k] = state;
+			}
+			allpassState = state;
+		} else if(frac == 0.0)
+			memcpy(out, src, n * sizeof(double));
+		else if(interpolation == DELAY_LINEAR)
+			for(unsigned int k = 0; k < n; k++)
+				out[k] = src[k] + frac * (src[k + 1] - src[k]);
+		else
+			for(unsigned int k = 0; k < n; k++) {
+				const double *x = src + k + first;
+				double y = 0.0;
+				for(unsigned int j = 0; j < taps; j++)
+					y += coeffs[j] * x[j];
+				out[k] = y;
+			}
+
+		const double *in = signal + i;
+		double *dest = buf + writePosition;
+		for(unsigned int k = 0; k < n; k++)
+			dest[k] = flushDenormal(in[k] + out[k] * feedback);
+		delayBuffer.commit(writePosition, n);
+
+		writePosition = (writePosition + n) & mask;
+		i += n;
+	}
+}
+
+/**
+ * Modulated delay or feedback. The control values for the block are gathered first. If every delay is
+ * long enough that nothing written in this block is read back, all reads are done in one pass and
+ * the writes in another. Otherwise samples are processed one at a time.
+ */
+void Delay::dspModulated() {
+	const unsigned int vsize = getVectorSize();
+	double shortest = bufferSize;
+	for(unsigned int i = 0; i < vsize; i++) {
 		checkModulation(i);
-		x = writePosition - delayTime;
-		if(x < 0)
-			x += bufferSize;
-		x1 = (int)x;
-		y1 = delayBuffer[x1];
-		x2 = x1 + 1 < bufferSize ? x1 + 1 : 0;
-		y2 = delayBuffer[x2];
-
-		vector[i] = y1 + ((x - x1) * (y2 - y1));
-		delayBuffer[writePosition] = signal[i] + vector[i] * feedback;
-		writePosition = writePosition < bufferSize ? writePosition + 1 : 0;
+		delayBlock[i] = delayTime;
+		feedbackBlock[i] = feedback;
+		shortest = std::min(shortest, delayTime);
+	}
+
+	double *buf = delayBuffer.data();
+	if(runLimit(shortest) >= (int)vsize) {
+		for(unsigned int i = 0; i < vsize; i++)
+			vector[i] = readDelayed(delayBlock[i], i);
+		double *dest = buf + writePosition;
+		for(unsigned int i = 0; i < vsize; i++)
+			dest[i] = flushDenormal(signal[i] + vector[i] * feedbackBlock[i]);
+		delayBuffer.commit(writePosition, vsize);
+		writePosition = (writePosition + vsize) & mask;
+		return;
+	}
+
+	for(unsigned int i = 0; i < vsize; i++) {
+		vector[i] = readDelayed(delayBlock[i], 0);
+		buf[writePosition] = flushDenormal(signal[i] + vector[i] * feedbackBlock[i]);
+		delayBuffer.commit(writePosition, 1);
+		writePosition = (writePosition + 1) & mask;
+	}
+}
+
+void Delay::dsp() {
+	if(delayTimeVector == NULL && feedbackVector == NULL && runLimit(delayTime) >= 1)
+		dspConstant();
+	else
+		dspModulated();
+}
+
+/**
+ * Skips dsp() once the input has been silent for longer than the tail. The buffer is kept while the
+ * line sleeps; what is left in it is below `def_silence`.
+ */
+void Delay::run() {
+	if(silence.update(inputSilent, getTailLength())) {
+		if(!silent)
+			setSilence();
+		return;
 	}
+	silent = false;
+	dsp();
+}
+
+unsigned long Delay::getTailLength() const {
+	if(feedbackVector != NULL)
+		return def_endlesstail;
+	// The longest delay plus the interpolation reach, for modulated delay times too.
+	return loopTail(bufferSize + 2, feedback);
 }
 
 double Delay::getFeedbackFromDecay(double decayTime) {
@@ -70,24 +214,33 @@ double Delay::getFeedbackFromDecay(double decayTime, double delTime) {
 
 void Allpass::dsp() {
 	//VERIFY *****************************************
-	double x1, x2, y1, y2, x, y, node;
+	// The allpass delay is the full buffer: it reads what was written bufferSize + 1 samples ago.
+	unsigned int span = (unsigned int)bufferSize + 1;
+	double delayed, node;
+	if(delayTimeVector == NULL && feedbackVector == NULL && span >= getVectorSize()) {
+		// Nothing written in this block is read back, and the mirrored ring makes the read and write
+		// spans contiguous, so the block is one straight loop.
+		const unsigned int vsize = getVectorSize();
+		const double *src = delayBuffer.data() + ((writePosition - span) & mask);
+		double *dest = delayBuffer.data() + writePosition;
+		for(unsigned int k = 0; k < vsize; k++) {
+			node = flushDenormal(signal[k] + src[k] * feedback);
+			vector[k] = src[k] - node * feedback;
+			dest[k] = node;
+		}
+		delayBuffer.commit(writePosition, vsize);
+		writePosition = (writePosition + vsize) & mask;
+		return;
+	}
+	double *buf = delayBuffer.data();
 	for(unsigned int i = 0; i < getVectorSize(); i++) {
 		checkModulation(i);
-		x = writePosition - delayTime;
-		if(x < 0)
-			x += bufferSize;
-		x1 = (int)x;
-		y1 = delayBuffer[x1];
-		x2 = x1 + 1 < bufferSize ? x1 + 1 : 0;
-		y2 = delayBuffer[x2];
-
-		y = y1 + ((x - x1) * (y2 - y1));
-
-		node = signal[i] + delayBuffer[writePosition] * feedback;
-		vector[i] = delayBuffer[writePosition] - node * feedback;
-		delayBuffer[writePosition] = node;
-		writePosition = writePosition < bufferSize ? writePosition + 1 : 0;
+		delayed = buf[(writePosition - span) & mask];
+		node = flushDenormal(signal[i] + delayed * feedback);
+		vector[i] = delayed - node * feedback;
+		buf[writePosition] = node;
+		delayBuffer.commit(writePosition, 1);
+		writePosition = (writePosition + 1) & mask;
 	}
 }
 
-
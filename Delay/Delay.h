@@ -9,7 +9,11 @@
 #define DELAY_H_
 
 #include "AudioBase.h"
+#include "FracDelay.h"
+#include "Silence.h"
+#include "MirrorRing.h"
 #include <vector>
+#include <algorithm>
 
 enum DELAY_TIME_METRIC {
 	SECONDS = 0,
@@ -22,7 +26,7 @@ protected:
 	double delayTime;
 	double bufferSize;
 	DELAY_TIME_METRIC metric;
-	std::vector<double> delayBuffer;
+	MirrorRing<double> delayBuffer;
 	const double *signal;
 	int writePosition;
 	int readPosition;
@@ -31,86 +35,112 @@ protected:
 
 	const double *delayTimeVector;
 	const double *feedbackVector;
+	unsigned int mask;
+	std::vector<double> delayBlock;
+	std::vector<double> feedbackBlock;
+	DELAY_INTERPOLATION interpolation;
+	const FracDelayTable *fracTable;
+	double allpassState;
+	bool inputSilent;
+	SilenceTracker silence;
 
 	virtual void setSampleWise(double &size);
 	virtual void checkModulation(int index);
 
 	virtual void dsp();
+	void run();
+	void dspConstant();
+	void dspModulated();
+	double readDelayed(double delay, unsigned int offset);
+	int runLimit(double delay) const;
 
 public:
 
 	Delay(const double bufferSize, const double feedback = 0.0, const DELAY_TIME_METRIC metric = SECONDS) :
-		delayTime(0.0), bufferSize(bufferSize), metric(metric), delayBuffer(1,0.0),
+		delayTime(0.0), bufferSize(bufferSize), metric(metric),
 		signal(NULL), writePosition(0), readPosition(0), rwPosition(0), feedback(feedback),
-		delayTimeVector(NULL), feedbackVector(NULL) {
+		delayTimeVector(NULL), feedbackVector(NULL), mask(0),
+		delayBlock(getVectorSize(), 0.0), feedbackBlock(getVectorSize(), 0.0),
+		interpolation(DELAY_LINEAR), fracTable(&FracDelayTable::get(DELAY_LINEAR)), allpassState(0.0),
+		inputSilent(false) {
 
 		setSampleWise(this->bufferSize);
 		this->bufferSize = (int)this->bufferSize;
 		delayTime = this->bufferSize;
-		delayBuffer.resize(this->bufferSize + 1, 0.0);
+		// One extra sample is needed to interpolate at the longest delay, and one more for Allpass, which
+		// reads bufferSize + 1 samples back. The buffer is a mirrored ring, so a block plus the
+		// interpolation taps can be read or written from any position without wrapping. It is
+		// allocated here and kept for the life of the line, so processing never allocates.
+		delayBuffer.allocate((unsigned int)std::max(this->bufferSize + 2, 2.0 * getVectorSize() + 16));
+		mask = delayBuffer.getMask();
 	}
 
 	virtual ~Delay() {}
 
-	virtual const AudioBuffer &process(const AudioBuffer &signal) {
+	void setInput(const AudioBuffer &signal) {
 		this->signal = signal.getVector();
+		inputSilent = signal.isSilent();
+	}
+
+	virtual const AudioBuffer &process(const AudioBuffer &signal) {
+		setInput(signal);
 		delayTime = bufferSize;
-		dsp();
+		run();
 		return *this;
 	}
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, double delayTime) {
-		this->signal = signal.getVector();
+		setInput(signal);
 		this->delayTime = delayTime;
 		setSampleWise(this->delayTime);
 		this->delayTime = this->delayTime <= bufferSize ?
 				(this->delayTime < 0 ? 0 : this->delayTime) : bufferSize;
-		dsp();
+		run();
 		return *this;
 	}
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, const AudioBuffer &delayTime) {
-		this->signal = signal.getVector();
+		setInput(signal);
 		delayTimeVector = delayTime.getVector();
-		dsp();
+		run();
 		return *this;
 	}
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, double delayTime, double feedback) {
-		this->signal = signal.getVector();
+		setInput(signal);
 		this->delayTime = delayTime;
 		setSampleWise(this->delayTime);
 		this->delayTime = this->delayTime <= bufferSize ?
 				(this->delayTime < 0 ? 0 : this->delayTime) : bufferSize;
 		this->feedback = feedback;
-		dsp();
+		run();
 		return *this;
 	}
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, const AudioBuffer &delayTime, double feedback) {
-		this->signal = signal.getVector();
+		setInput(signal);
 		this->delayTimeVector = delayTime.getVector();
 		this->feedback = feedback;
-		dsp();
+		run();
 		return *this;
 	}
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, double delayTime, const AudioBuffer &feedback) {
-		this->signal = signal.getVector();
+		setInput(signal);
 		this->delayTime = delayTime;
 		setSampleWise(this->delayTime);
 		this->delayTime = this->delayTime <= bufferSize ?
 				(this->delayTime < 0 ? 0 : this->delayTime) : bufferSize;
 		this->feedbackVector = feedback.getVector();
-		dsp();
+		run();
 		return *this;
 	}
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, const AudioBuffer &delayTime, const AudioBuffer &feedback) {
-		this->signal = signal.getVector();
+		setInput(signal);
 		this->delayTimeVector = delayTime.getVector();
 		this->feedbackVector = feedback.getVector();
-		dsp();
+		run();
 		return *this;
 	}
 
@@ -135,9 +165,32 @@ public:
 	virtual const AudioBuffer &operator()(const AudioBuffer &signal, const AudioBuffer &delayTime, const AudioBuffer &feedback) {
 		return process(signal, delayTime, feedback); }
 
+	/**
+	 * Selects how fractional delay times are read. Linear by default.
+	 */
+	void setInterpolation(DELAY_INTERPOLATION type) {
+		interpolation = type;
+		fracTable = &FracDelayTable::get(type);
+		allpassState = 0.0;
+	}
+
+	DELAY_INTERPOLATION getInterpolation() const {
+		return interpolation;
+	}
+
 	double getFeedbackFromDecay(double decayTime);
 
-	double getFeedbackFromDecay(double decayTime, double delayTime);
+	/**
+	 * Number of samples the output takes to fall below `def_silence` after the input goes silent. Once
+	 * the input has been marked silent for this long, processing stops and the output is marked silent
+	 * until sound arrives again.
+	 */
+	virtual unsigned long getTailLength() const;
+
+	/**
+	 * Feedback gain for which a loop of `delayTime` seconds decays by 60 dB in `decayTime` seconds.
+	 */
+	static double getFeedbackFromDecay(double decayTime, double delayTime);
 
 	double getDelayTime() const {
 		return delayTime;
@@ -151,6 +204,23 @@ public:
 		return feedback;
 	}
 
+	/**
+	 * Clears the line and returns the memory pages of its buffer to the system. The pages are committed
+	 * again as the line writes to them. Makes system calls, so call it outside the audio callback, for
+	 * example on a voice that has been idle for a while.
+	 */
+	void releaseMemory() {
+		delayBuffer.discard();
+		allpassState = 0.0;
+	}
+
+	/**
+	 * Number of samples of delay memory currently allocated.
+	 */
+	unsigned int getAllocatedLength() const {
+		return delayBuffer.getLength();
+	}
+
 	void setFeedback(double feedback) {
 		this->feedback = feedback;
 	}
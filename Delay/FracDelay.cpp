@@ -0,0 +1,94 @@
+/*
+ * FracDelay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "FracDelay.h"
+
+FracDelayTable::FracDelayTable(unsigned int order, unsigned int phases) :
+		taps(order + 1), first(-(int)(order - 1) / 2), phases(phases) {
+	// Row p holds the Lagrange basis polynomials over nodes first .. first + taps - 1, evaluated at
+	// p / phases. One extra row covers a fraction of exactly 1.
+	rows.resize((phases + 1) * taps);
+	for(unsigned int p = 0; p <= phases; p++) {
+		double x = (double) p / phases;
+		for(unsigned int j = 0; j < taps; j++) {
+			double node = first + (int) j, coeff = 1.0;
+			for(unsigned int m = 0; m < taps; m++)
+				if(m != j)
+					coeff *= (x - (first + (int) m)) / (node - (first + (int) m));
+			rows[p * taps + j] = coeff;
+		}
+	}
+}
+
+const FracDelayTable &FracDelayTable::get(DELAY_INTERPOLATION type) {
+	static const FracDelayTable linear(1);
+	static const FracDelayTable lagrange3(3);
+	static const FracDelayTable lagrange5(5);
+	switch(type) {
+	case DELAY_LAGRANGE5:
+		return lagrange5;
+	case DELAY_LAGRANGE3:
+		return lagrange3;
+	default:
+		return linear;
+	}
+}
+
+namespace {
+
+std::vector<double> makeThiranTable() {
+	std::vector<double> table(def_fracphases + 2);
+	for(unsigned int p = 0; p <= def_fracphases; p++) {
+		double d = 0.5 + (double) p / def_fracphases;
+		table[p] = (1.0 - d) / (1.0 + d);
+	}
+	table[def_fracphases + 1] = table[def_fracphases];
+	return table;
+}
+
+}
+
+double FracDelayTable::thiran(double delay) {
+	static const std::vector<double> table = makeThiranTable();
+	double pos = (delay - 0.5) * def_fracphases;
+	if(pos < 0)
+		pos = 0;
+	if(pos > def_fracphases)
+		pos = def_fracphases;
+	unsigned int p = (unsigned int) pos;
+	return table[p] + (pos - p) * (table[p + 1] - table[p]);
+}
+
+void FracDelayTable::getCoefficients(double frac, double *coeffs) const {
+	double pos = frac * phases;
+	unsigned int p = (unsigned int) pos;
+	if(p >= phases)
+		p = phases - 1;
+	double a = pos - p;
+	const double *row0 = &rows[p * taps];
+	const double *row1 = row0 + taps;
+	for(unsigned int j = 0; j < taps; j++)
+		coeffs[j] = row0[j] + a * (row1[j] - row0[j]);
+}
+
+double FracDelayTable::interpolate(const double *x, double frac) const {
+	double pos = frac * phases;
+	unsigned int p = (unsigned int) pos;
+	if(p >= phases)
+		p = phases - 1;
+	double a = pos - p;
+	const double *row0 = &rows[p * taps];
+	const double *row1 = row0 + taps;
+	const double *in = x + first;
+
+	double y0 = 0.0, y1 = 0.0;
+	for(unsigned int j = 0; j < taps; j++) {
+		y0 += in[j] * row0[j];
+		y1 += in[j] * row1[j];
+	}
+	return y0 + a * (y1 - y0);
+}
@@ -0,0 +1,81 @@
+/*
+ * FracDelay.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef FRACDELAY_H_
+#define FRACDELAY_H_
+
+#include <vector>
+
+/**
+ * Interpolation used to read fractional delays.
+ * DELAY_LINEAR - Two point linear interpolation.
+ * DELAY_LAGRANGE3 - Four point, third order Lagrange interpolation.
+ * DELAY_LAGRANGE5 - Six point, fifth order Lagrange interpolation.
+ * DELAY_THIRAN - First order Thiran allpass. Flat magnitude response, which suits tuned feedback loops in
+ * physical models, but it has internal state and so is best with fixed or slowly varying delays.
+ */
+enum DELAY_INTERPOLATION {
+	DELAY_LINEAR = 0,
+	DELAY_LAGRANGE3,
+	DELAY_LAGRANGE5,
+	DELAY_THIRAN
+};
+
+/**
+ * Number of fractional positions per sample in the coefficient tables.
+ */
+const unsigned int def_fracphases = 1024;
+
+/**
+ * Lagrange interpolation coefficients precomputed for `def_fracphases` fractions. Coefficients for
+ * fractions between table rows are linearly interpolated, so an interpolated read is two short dot
+ * products. Tables are shared: use get() to obtain one.
+ *
+ * A read at `x[0] + frac` uses the samples from `x[getFirst()]` to `x[getFirst() + getTaps() - 1]`.
+ */
+class FracDelayTable {
+protected:
+	unsigned int taps;
+	int first;
+	unsigned int phases;
+	std::vector<double> rows;
+
+	FracDelayTable(unsigned int order, unsigned int phases = def_fracphases);
+
+public:
+	/**
+	 * Returns the shared table for a Lagrange interpolation mode. DELAY_LINEAR gives the first order table.
+	 */
+	static const FracDelayTable &get(DELAY_INTERPOLATION type);
+
+	/**
+	 * First order Thiran allpass coefficient for a fractional delay `delay` in [0.5, 1.5], read from a
+	 * table. The allpass y[n] = a x[n] + x[n-1] - a y[n-1] then delays by `delay` samples at low frequencies.
+	 */
+	static double thiran(double delay);
+
+	unsigned int getTaps() const { return taps; }
+
+	int getFirst() const { return first; }
+
+	/**
+	 * Number of samples after x[0] that a read uses.
+	 */
+	int getReach() const { return first + (int) taps - 1; }
+
+	/**
+	 * Writes the getTaps() coefficients for fraction `frac` to `coeffs`.
+	 */
+	void getCoefficients(double frac, double *coeffs) const;
+
+	/**
+	 * Interpolated value at `x[0] + frac`, 0 <= frac <= 1.
+	 */
+	double interpolate(const double *x, double frac) const;
+};
+
+#endif /* FRACDELAY_H_ */
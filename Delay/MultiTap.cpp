@@ -0,0 +1,181 @@
+/*
+ * MultiTap.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "MultiTap.h"
+#include "Denormal.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+MultiTapDelay::MultiTapDelay(double maxDelay, DELAY_TIME_METRIC metric) :
+		bufferSize(0), metric(metric), mask(0), writePosition(0),
+		feedbackSum(getVectorSize(), 0.0) {
+	bufferSize = (int)toSamples(maxDelay);
+}
+
+double MultiTapDelay::toSamples(double time) const {
+	switch(metric) {
+	case SECONDS:
+		return time * getSrate();
+	case MILLIS:
+		return time * getSrate() / 1000.0;
+	case SAMPS:
+	default:
+		return time;
+	}
+}
+
+void MultiTapDelay::checkTap(unsigned int tap) {
+	if(tap >= tapDelay.size()) {
+		exception.setError(SIZE_MISMATCH, "Tap index out of range", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+}
+
+unsigned int MultiTapDelay::addTap(double delayTime, double gain, double feedback) {
+	if(delayBuffer.getLength() == 0) {
+		// Room for the longest tap plus its interpolation point, and for a whole block of reads or writes
+		// starting anywhere in the mirrored ring.
+		delayBuffer.allocate((unsigned int)std::max(bufferSize + 2, 2.0 * getVectorSize() + 2));
+		mask = delayBuffer.getMask();
+	}
+	tapDelay.push_back(0.0);
+	tapGain.push_back(0.0);
+	tapFeedback.push_back(0.0);
+	tapModulation.push_back(NULL);
+	tapOutputs.resize(tapDelay.size() * getVectorSize(), 0.0);
+	unsigned int tap = (unsigned int) tapDelay.size() - 1;
+	setTap(tap, delayTime, gain, feedback);
+	return tap;
+}
+
+void MultiTapDelay::setTap(unsigned int tap, double delayTime, double gain, double feedback) {
+	checkTap(tap);
+	tapDelay[tap] = std::min(std::max(toSamples(delayTime), 0.0), bufferSize);
+	tapGain[tap] = gain;
+	tapFeedback[tap] = feedback;
+}
+
+void MultiTapDelay::setTapModulation(unsigned int tap, const AudioBuffer *delayTime) {
+	checkTap(tap);
+	tapModulation[tap] = delayTime;
+}
+
+/**
+ * Reads samples `from` to `to` of a tap's output for this block. Sample i is read relative to
+ * writePosition + i. A fixed tap reads a contiguous span of the mirrored ring.
+ */
+void MultiTapDelay::readTap(unsigned int tap, unsigned int from, unsigned int to) {
+	const double *buf = delayBuffer.data();
+	double *out = &tapOutputs[tap * getVectorSize()];
+	if(tapModulation[tap] == NULL) {
+		long whole = (long)ceil(tapDelay[tap]);
+		double frac = whole - tapDelay[tap];
+		const double *src = buf + ((writePosition - whole) & mask);
+		for(unsigned int i = from; i < to; i++)
+			out[i] = src[i] + frac * (src[i + 1] - src[i]);
+	} else {
+		const double *mod = tapModulation[tap]->getVector();
+		for(unsigned int i = from; i < to; i++) {
+			double delay = std::min(std::max(toSamples(mod[i]), 0.0), bufferSize);
+			long whole = (long)ceil(delay);
+			unsigned int index = (writePosition + i - whole) & mask;
+			out[i] = buf[index] + (whole - delay) * (buf[index + 1] - buf[index]);
+		}
+	}
+}
+
+/**
+ * The taps' feedback gains add up to at most the loop gain, and every loop is at most the longest
+ * delay.
+ */
+unsigned long MultiTapDelay::getTailLength() const {
+	double loopGain = 0.0;
+	for(unsigned int t = 0; t < tapFeedback.size(); t++)
+		loopGain += fabs(tapFeedback[t]);
+	return loopTail(bufferSize + 2, loopGain);
+}
+
+/**
+ * Without feedback the input block is written first and the taps read afterwards. With feedback, if
+ * every tap is at least a block long the taps only read samples written before this block, so they are
+ * read for the whole block before writing. Otherwise the block is processed one sample at a time.
+ */
+const AudioBuffer &MultiTapDelay::process(const AudioBuffer &sig) {
+	const unsigned int vsize = getVectorSize();
+	const unsigned int taps = getTaps();
+	const double *signal = sig.getVector();
+
+	if(taps == 0) {
+		if(!silent)
+			setSilence();
+		return *this;
+	}
+	if(silence.update(sig.isSilent(), getTailLength())) {
+		if(!silent) {
+			std::fill(tapOutputs.begin(), tapOutputs.end(), 0.0);
+			setSilence();
+		}
+		return *this;
+	}
+	silent = false;
+
+	bool recirculate = false;
+	double shortest = bufferSize;
+	for(unsigned int t = 0; t < taps; t++) {
+		recirculate = recirculate || tapFeedback[t] != 0.0;
+		if(tapModulation[t] == NULL)
+			shortest = std::min(shortest, tapDelay[t]);
+		else {
+			const double *mod = tapModulation[t]->getVector();
+			for(unsigned int i = 0; i < vsize; i++)
+				shortest = std::min(shortest, toSamples(mod[i]));
+		}
+	}
+
+	double *dest = delayBuffer.data() + writePosition;
+	if(!recirculate) {
+		memcpy(dest, signal, vsize * sizeof(double));
+		delayBuffer.commit(writePosition, vsize);
+		for(unsigned int t = 0; t < taps; t++)
+			readTap(t, 0, vsize);
+	} else if(shortest >= vsize) {
+		std::fill(feedbackSum.begin(), feedbackSum.end(), 0.0);
+		for(unsigned int t = 0; t < taps; t++) {
+			readTap(t, 0, vsize);
+			const double *out = &tapOutputs[t * vsize];
+			double fb = tapFeedback[t];
+			for(unsigned int i = 0; i < vsize; i++)
+				feedbackSum[i] += fb * out[i];
+		}
+		for(unsigned int i = 0; i < vsize; i++)
+			dest[i] = flushDenormal(signal[i] + feedbackSum[i]);
+		delayBuffer.commit(writePosition, vsize);
+	} else {
+		for(unsigned int i = 0; i < vsize; i++) {
+			double sum = 0.0;
+			for(unsigned int t = 0; t < taps; t++) {
+				readTap(t, i, i + 1);
+				sum += tapFeedback[t] * tapOutputs[t * vsize + i];
+			}
+			dest[i] = flushDenormal(signal[i] + sum);
+			delayBuffer.commit(writePosition + i, 1);
+		}
+	}
+	writePosition = (writePosition + vsize) & mask;
+
+	std::fill(vector.begin(), vector.end(), 0.0);
+	for(unsigned int t = 0; t < taps; t++) {
+		const double *out = &tapOutputs[t * vsize];
+		double gain = tapGain[t];
+		for(unsigned int i = 0; i < vsize; i++)
+			vector[i] += gain * out[i];
+	}
+	return *this;
+}
@@ -0,0 +1,101 @@
+/*
+ * MultiTap.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef MULTITAP_H_
+#define MULTITAP_H_
+
+#include "AudioBase.h"
+#include "Delay.h"
+#include "Silence.h"
+#include "MirrorRing.h"
+#include <vector>
+
+/**
+ * Delay line with any number of read taps. The input is written once per sample into a single buffer
+ * and every tap reads from it with its own delay time, output gain and feedback gain. The value written
+ * is the input plus the sum of each tap's output times its feedback gain, so taps can form a
+ * recirculating network (for example the comb section of SReverb), or with zero feedback a bank of
+ * echoes for early reflections or a multi-voice chorus.
+ *
+ * The output vector is the sum of the taps scaled by their gains; each tap's output is also available
+ * on its own through getTap().
+ *
+ * The buffer is allocated when the first tap is added, so a line that never gets a tap (such as the
+ * unused one of an SReverb without `sharedLine`) holds no memory and outputs silence. As with Delay,
+ * processing stops while the line is idle.
+ */
+class MultiTapDelay : public AudioBuffer {
+protected:
+	double bufferSize;
+	DELAY_TIME_METRIC metric;
+	MirrorRing<double> delayBuffer;
+	unsigned int mask;
+	unsigned int writePosition;
+
+	std::vector<double> tapDelay;
+	std::vector<double> tapGain;
+	std::vector<double> tapFeedback;
+	std::vector<const AudioBuffer *> tapModulation;
+	std::vector<double> tapOutputs;
+	std::vector<double> feedbackSum;
+	SilenceTracker silence;
+
+	double toSamples(double time) const;
+	void checkTap(unsigned int tap);
+	void readTap(unsigned int tap, unsigned int from, unsigned int to);
+
+public:
+	/**
+	 * @param maxDelay Longest delay of any tap.
+	 * @param metric Unit of all delay times given to this object.
+	 */
+	MultiTapDelay(double maxDelay, DELAY_TIME_METRIC metric = SECONDS);
+
+	virtual ~MultiTapDelay() {}
+
+	/**
+	 * Adds a tap and returns its index.
+	 * @param delayTime Delay of the tap, clamped to the maximum delay.
+	 * @param gain Gain of the tap in the output mix.
+	 * @param feedback Gain with which the tap is fed back into the line. For stability the feedback gains
+	 * of all taps should add up to less than 1 in magnitude.
+	 */
+	unsigned int addTap(double delayTime, double gain = 1.0, double feedback = 0.0);
+
+	void setTap(unsigned int tap, double delayTime, double gain, double feedback);
+
+	/**
+	 * Modulates the delay time of a tap sample by sample from `delayTime`, read on every process() call.
+	 * Pass NULL to go back to the fixed delay time.
+	 */
+	void setTapModulation(unsigned int tap, const AudioBuffer *delayTime);
+
+	unsigned int getTaps() const { return (unsigned int) tapDelay.size(); }
+
+	/**
+	 * Clears the line and returns its memory pages to the system, as Delay::releaseMemory(). Not for use
+	 * in the audio callback.
+	 */
+	void releaseMemory() { delayBuffer.discard(); }
+
+	/**
+	 * Tail in samples, taking the sum of the feedback gains as the loop gain. Processing stops once the
+	 * input has been silent this long, as in Delay.
+	 */
+	unsigned long getTailLength() const;
+
+	/**
+	 * Output of a tap from the last process() call, before its gain is applied.
+	 */
+	const double *getTap(unsigned int tap) const { return &tapOutputs[tap * vectorSize]; }
+
+	const AudioBuffer &process(const AudioBuffer &signal);
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+#endif /* MULTITAP_H_ */
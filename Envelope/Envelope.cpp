@@ -5,6 +5,48 @@
  *      Author: Thrifleganger
  */
 #include "Envelope.h"
+#include <algorithm>
+
+/**
+ * True if every sample of the block is zero. Only called once an envelope holds at zero, so that
+ * downstream modules can see the silence.
+ */
+static bool isZero(const std::vector<double> &block) {
+	for(unsigned int i = 0; i < block.size(); i++)
+		if(block[i] != 0.0)
+			return false;
+	return true;
+}
+
+/**
+ * Writes `n` samples of a line: sample k is `start + (index + k) * increment`, where `index` is the
+ * number of samples since the start of the segment. Each sample is computed from the segment start,
+ * so samples do not depend on each other and no rounding error builds up.
+ */
+static void fillLine(double *out, int n, double start, double increment, long index) {
+	const double first = (double)index;
+	for(int k = 0; k < n; k++)
+		out[k] = start + (first + k) * increment;
+}
+
+/**
+ * Writes `n` samples of an exponential curve: sample k is `start * ratio^(index + k)`. The power at
+ * the start of the run is computed once and each sample is scaled from it by `powers[k] = ratio^k`.
+ */
+static void fillCurve(double *out, int n, double start, double ratio, long index, const double *powers) {
+	const double first = start * pow(ratio, (double)index);
+	for(int k = 0; k < n; k++)
+		out[k] = first * powers[k];
+}
+
+/**
+ * Table of ratio^k for one vector. Recomputed whenever the ratio changes.
+ */
+static void setPowers(std::vector<double> &powers, double ratio) {
+	powers.resize(AudioParams::getVectorSize());
+	for(unsigned int k = 0; k < powers.size(); k++)
+		powers[k] = pow(ratio, (double)k);
+}
 
 // Function definitions for SingleSegment Class
 SingleSegment::SingleSegment(double start, double dur, double end, bool hold /*=true*/, bool repeat /*=false*/){
@@ -18,64 +60,79 @@ SingleSegment::SingleSegment(double start, double dur, double end, bool hold /*=
 	this->repeat = repeat;
 }
 
+/**
+ * The segment runs from count 0 to `duration` inclusive. After that a repeating envelope starts over.
+ */
+void SingleSegment::settle() {
+	if(repeat && count > duration)
+		retrigger();
+}
+
+/**
+ * Number of the next `available` samples that follow the same formula: the rest of the segment, or
+ * everything once the envelope holds or continues past its end.
+ */
+long SingleSegment::runLength(long available) const {
+	if(count > duration || !(hold || repeat))
+		return available;
+	return std::min(available, duration + 1 - count);
+}
+
+bool SingleSegment::holding() const {
+	return hold && count > duration;
+}
+
 // Function definitions for Lineseg Class
 void Lineseg::generate() {
-	for(unsigned int i = 0; i < getVectorSize(); i++){
-		vector[i] = currentPos;
-		if(count < duration){
-			currentPos += increment;
-			count++;
-		} else{
-			if(repeat)
-				Lineseg::retrigger();
-			else{
-				if(hold)
-					currentPos = endPos;
-				else
-					currentPos += increment;
-					count++;
-			}
-
-		}
+	const long vsize = getVectorSize();
+	long n;
+	for(long i = 0; i < vsize; i += n) {
+		settle();
+		n = runLength(vsize - i);
+		if(holding())
+			std::fill(vector.begin() + i, vector.begin() + i + n, endPos);
+		else
+			fillLine(&vector[i], n, startPos, increment, count);
+		count += n;
 	}
+	settle();
+	currentPos = holding() ? endPos : startPos + count * increment;
+	silent = hold && !repeat && count >= duration && currentPos == 0.0 && isZero(vector);
 }
 
 void Lineseg::retrigger() {
 	count = 0;
 	currentPos = startPos;
-	increment = (endPos - startPos) / duration;
+	increment = duration > 0 ? (endPos - startPos) / duration : 0.0;
 }
 
 Lineseg::Lineseg(double start, double dur, double end, bool hold /*=true*/, bool repeat /*=false*/) :
 	SingleSegment(start, dur, end, hold, repeat) {
-	increment = (endPos - startPos) / duration;
+	Lineseg::retrigger();
 }
 
 //Function definitions for Expseg Class
 void Expseg::generate() {
-	for(unsigned int i = 0; i < getVectorSize(); i++){
-		vector[i] = currentPos;
-		if(count < duration){
-			currentPos *= increment;
-			count++;
-		} else{
-			if(repeat)
-				Expseg::retrigger();
-			else{
-				if(hold)
-					currentPos = endPos;
-				else
-					currentPos *= increment;
-					count++;
-			}
-		}
+	const long vsize = getVectorSize();
+	long n;
+	for(long i = 0; i < vsize; i += n) {
+		settle();
+		n = runLength(vsize - i);
+		if(holding())
+			std::fill(vector.begin() + i, vector.begin() + i + n, endPos);
+		else
+			fillCurve(&vector[i], n, startPos, increment, count, &powers[0]);
+		count += n;
 	}
+	settle();
+	currentPos = holding() ? endPos : startPos * pow(increment, (double)count);
 }
 
 void Expseg::retrigger() {
 	count = 0;
 	currentPos = startPos;
 	increment = pow((endPos / startPos), 1/(double)duration);
+	setPowers(powers, increment);
 }
 
 Expseg::Expseg(double start, double dur, double end, bool hold /*=true*/, bool repeat /*=false*/) :
@@ -84,8 +141,7 @@ Expseg::Expseg(double start, double dur, double end, bool hold /*=true*/, bool r
 		startPos = 0.001;
 	if(end == 0.0)
 		endPos = 0.001;
-	currentPos = startPos;
-	increment = pow((endPos / startPos), 1/(double)duration);
+	Expseg::retrigger();
 }
 
 //Function definitions for Multisegment Class
@@ -100,6 +156,7 @@ MultiSegment::MultiSegment(std::vector<double> position, std::vector<double> tim
 	currentStart = position[0];
 	currentEnd = position[1];
 	currentDuration = time[0];
+	segmentStart = 0;
 	numPositions = position.size();
 	numTimes = time.size();
 	vectorCount = 0;
@@ -107,97 +164,112 @@ MultiSegment::MultiSegment(std::vector<double> position, std::vector<double> tim
 	this->repeat = repeat;
 }
 
+/**
+ * Moves to the next segment when `count` reaches the end of the current one. The last segment runs to
+ * `currentDuration` inclusive, after which a repeating envelope starts over.
+ */
+void MultiSegment::settle() {
+	for(;;) {
+		if(vectorCount < numTimes - 1 && count >= currentDuration)
+			recompute();
+		else if(repeat && count > currentDuration)
+			retrigger();
+		else
+			break;
+	}
+}
+
+long MultiSegment::runLength(long available) const {
+	if(vectorCount < numTimes - 1)
+		return std::min(available, (long)currentDuration - count);
+	if(count > currentDuration || !(hold || repeat))
+		return available;
+	return std::min(available, (long)currentDuration + 1 - count);
+}
+
+bool MultiSegment::holding() const {
+	return hold && vectorCount >= numTimes - 1 && count > currentDuration;
+}
+
 //Function definitions for Linesegs Class
 void Linesegs::generate() {
-	for(unsigned int i = 0; i < getVectorSize(); i++){
-		vector[i] = currentPos;
-		if(count < currentDuration){
-			currentPos += increment;
-			count++;
-		} else {
-			if (vectorCount < numTimes - 1) {
-				recompute();
-				currentPos += increment;
-			}
-			else {
-				if(repeat)
-					Linesegs::retrigger();
-				else{
-					if(hold)
-						currentPos = currentEnd;
-					else
-						currentPos += increment;
-						count++;
-				}
-			}
-		}
+	const long vsize = getVectorSize();
+	long n;
+	for(long i = 0; i < vsize; i += n) {
+		settle();
+		n = runLength(vsize - i);
+		if(holding())
+			std::fill(vector.begin() + i, vector.begin() + i + n, currentEnd);
+		else
+			fillLine(&vector[i], n, currentStart, increment, count - segmentStart);
+		count += n;
 	}
+	settle();
+	currentPos = holding() ? currentEnd : currentStart + (count - segmentStart) * increment;
+	silent = hold && !repeat && vectorCount >= numTimes - 1 && count >= currentDuration && currentPos == 0.0
+			&& isZero(vector);
 }
 
 void Linesegs::retrigger() {
 	vectorCount = 0;
 	count = 0;
+	segmentStart = 0;
 	currentStart = position[0];
 	currentEnd = position[1];
 	currentDuration = time[0];
 	currentPos = position[0];
-	increment = (currentEnd - currentStart) / time[0];
+	increment = time[0] > 0 ? (currentEnd - currentStart) / time[0] : 0.0;
 }
 
 void Linesegs::recompute() {
+	segmentStart = currentDuration;
 	currentStart = position[++vectorCount];
 	currentEnd = position[vectorCount + 1];
 	currentDuration += time[vectorCount];
-	increment = (currentEnd - currentStart) / time[vectorCount];
+	increment = time[vectorCount] > 0 ? (currentEnd - currentStart) / time[vectorCount] : 0.0;
 }
 
 Linesegs::Linesegs(std::vector<double> posVect, std::vector<double> timeVect, bool hold, bool repeat) :
 	MultiSegment(posVect,timeVect,hold,repeat) {
-	increment = (currentEnd - currentStart) / currentDuration;
+	Linesegs::retrigger();
 }
 
 //Function definitions for Expsegs Class
 void Expsegs::generate() {
-	for(unsigned int i = 0; i < getVectorSize(); i++){
-		vector[i] = currentPos;
-		if(count < currentDuration){
-			currentPos *= increment;
-			count++;
-		} else {
-			if (vectorCount < numTimes - 1) {
-				recompute();
-				currentPos *= increment;
-			}
-			else {
-				if(repeat)
-					Expsegs::retrigger();
-				else {
-					if(hold)
-						currentPos = currentEnd;
-					else
-						currentPos *= increment;
-						count++;
-				}
-			}
-		}
+	const long vsize = getVectorSize();
+	long n;
+	for(long i = 0; i < vsize; i += n) {
+		settle();
+		n = runLength(vsize - i);
+		if(holding())
+			std::fill(vector.begin() + i, vector.begin() + i + n, currentEnd);
+		else
+			fillCurve(&vector[i], n, currentStart, increment, count - segmentStart, &powers[0]);
+		count += n;
 	}
+	settle();
+	currentPos = holding() ? currentEnd : currentStart * pow(increment, (double)(count - segmentStart));
 }
 
 void Expsegs::retrigger() {
 	vectorCount = 0;
 	count = 0;
+	segmentStart = 0;
 	currentStart = position[0];
 	currentEnd = position[1];
 	currentDuration = time[0];
 	currentPos = position[0];
 	increment = pow((currentEnd / currentStart), 1/time[vectorCount]);
+	setPowers(powers, increment);
 }
 
 void Expsegs::recompute() {
+	segmentStart = currentDuration;
 	currentStart = position[++vectorCount];
 	currentEnd = position[vectorCount + 1];
 	currentDuration += time[vectorCount];
 	increment = pow((currentEnd / currentStart), 1/time[vectorCount]);
+	setPowers(powers, increment);
 }
 
 Expsegs::Expsegs(std::vector<double> posVect, std::vector<double> timeVect, bool hold, bool repeat) :
@@ -206,6 +278,5 @@ Expsegs::Expsegs(std::vector<double> posVect, std::vector<double> timeVect, bool
 		if(position[i] == 0)
 			position[i] = 0.001;
 	}
-	currentPos = position[0];
-	increment = pow((currentEnd / currentStart), 1/(double)currentDuration);
+	Expsegs::retrigger();
 }
@@ -46,6 +46,10 @@ protected:
 
 	virtual void retrigger() = 0;
 
+	void settle();
+	long runLength(long available) const;
+	bool holding() const;
+
 	//virtual void checkInputValues();
 
 public:
@@ -140,6 +144,8 @@ public:
 class Expseg : public SingleSegment{
 
 protected:
+	std::vector<double> powers;
+
 	void generate();
 	void retrigger();
 
@@ -172,6 +178,7 @@ protected:
 	double currentPos;
 	double increment;
 	int currentDuration;
+	int segmentStart;
 	double currentStart;
 	double currentEnd;
 	double numPositions;
@@ -186,6 +193,10 @@ protected:
 
 	virtual void recompute() = 0;
 
+	void settle();
+	long runLength(long available) const;
+	bool holding() const;
+
 public:
 	MultiSegment(std::vector<double> position, std::vector<double> timeVect, bool hold = true, bool repeat = false);
 
@@ -274,6 +285,8 @@ public:
  */
 class Expsegs: public MultiSegment{
 protected:
+	std::vector<double> powers;
+
 	void generate();
 	void retrigger();
 	void recompute();
@@ -25,7 +25,8 @@ enum ERROR_TYPE{
 		OPEN_FILE_TO_READ,
 		OPEN_FILE_TO_WRITE,
 		SEEK_BEYOND_FILE,
-		UNEXPECTED_CHANNELS
+		UNEXPECTED_CHANNELS,
+		UNSUPPORTED_FORMAT
 	};
 
 /**
@@ -80,6 +81,9 @@ public:
 		case UNEXPECTED_CHANNELS:
 			std::cerr << "Unexpected number of audio channels encountered. " << errorMessage << std::endl;
 			break;
+		case UNSUPPORTED_FORMAT:
+			std::cerr << "Unsupported file format. " << errorMessage << std::endl;
+			break;
 		}
 	}
 
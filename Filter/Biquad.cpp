@@ -0,0 +1,204 @@
+/*
+ * Biquad.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "Biquad.h"
+#include "Denormal.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+BiquadBank::BiquadBank(unsigned int lanes, unsigned int sections) :
+		lanes(lanes), sections(sections), groups((lanes + def_biquadgroup - 1) / def_biquadgroup) {
+	if(lanes == 0 || sections == 0) {
+		exception.setError(ZERO_VALUE, "Biquad bank needs at least one lane and one section", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+	unsigned int width = groups * def_biquadgroup;
+	coeffs.resize(sections * 5 * width, 0.0);
+	state.resize(sections * 2 * width, 0.0);
+	work.resize(vectorSize * width, 0.0);
+	outputs.resize(vectorSize * lanes, 0.0);
+	// Every section starts as a pass through.
+	for(unsigned int s = 0; s < sections; s++)
+		std::fill(coeff(s, 0), coeff(s, 0) + width, 1.0);
+}
+
+void BiquadBank::checkLane(int lane) {
+	if(lane >= (int) lanes) {
+		exception.setError(SIZE_MISMATCH, "Lane index out of range", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+}
+
+/**
+ * Stores b0, b1, b2, a1, a2 for one section of one lane, or of every lane when `lane` is negative.
+ */
+void BiquadBank::setSection(int lane, unsigned int section, const double *c) {
+	unsigned int first = lane < 0 ? 0 : lane;
+	unsigned int last = lane < 0 ? lanes : lane + 1;
+	for(unsigned int k = 0; k < 5; k++)
+		for(unsigned int l = first; l < last; l++)
+			coeff(section, k)[l] = c[k];
+}
+
+void BiquadBank::setCoefficients(int lane, unsigned int section, double b0, double b1, double b2,
+		double a1, double a2) {
+	checkLane(lane);
+	if(section >= sections) {
+		exception.setError(SIZE_MISMATCH, "Section index out of range", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+	double c[5] = { b0, b1, b2, a1, a2 };
+	setSection(lane, section, c);
+}
+
+/**
+ * Bilinear transform Butterworth design. Pole pairs become second order sections with
+ * Q = 1 / (2 sin((2k + 1) pi / 2N)); an odd order adds one first order section.
+ */
+void BiquadBank::setButterworth(double cutOff, unsigned int order, int lane, bool highPass) {
+	checkLane(lane);
+	unsigned int needed = (order + 1) / 2;
+	if(order == 0 || needed > sections) {
+		exception.setError(SIZE_MISMATCH, "Filter order needs more sections than the bank has", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+
+	double K = tan(PI * cutOff / getSrate());
+	for(unsigned int s = 0; s < sections; s++) {
+		double c[5] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+		if(s < order / 2) {
+			double Q = 1.0 / (2.0 * sin((2 * s + 1) * PI / (2.0 * order)));
+			double norm = 1.0 / (1.0 + K / Q + K * K);
+			c[0] = highPass ? norm : K * K * norm;
+			c[1] = highPass ? -2.0 * c[0] : 2.0 * c[0];
+			c[2] = c[0];
+			c[3] = 2.0 * (K * K - 1.0) * norm;
+			c[4] = (1.0 - K / Q + K * K) * norm;
+		} else if(s < needed) {
+			double norm = 1.0 / (1.0 + K);
+			c[0] = highPass ? norm : K * norm;
+			c[1] = highPass ? -c[0] : c[0];
+			c[3] = (K - 1.0) * norm;
+		}
+		setSection(lane, s, c);
+	}
+}
+
+void BiquadBank::setButterworthLP(double cutOff, unsigned int order, int lane) {
+	setButterworth(cutOff, order, lane, false);
+}
+
+void BiquadBank::setButterworthHP(double cutOff, unsigned int order, int lane) {
+	setButterworth(cutOff, order, lane, true);
+}
+
+void BiquadBank::reset() {
+	std::fill(state.begin(), state.end(), 0.0);
+}
+
+/**
+ * With silent input and the memory of every lane below `def_silentstate`, clears the memory and marks the
+ * output silent, and the block can be skipped.
+ */
+bool BiquadBank::sleep(bool inputSilent) {
+	if(!inputSilent) {
+		silent = false;
+		return false;
+	}
+	if(silent)
+		return true;
+	for(unsigned int k = 0; k < state.size(); k++)
+		if(fabs(state[k]) >= def_silentstate)
+			return false;
+	reset();
+	std::fill(outputs.begin(), outputs.end(), 0.0);
+	setSilence();
+	return true;
+}
+
+/**
+ * Filters `work`, which holds each group's block with the group's lanes interleaved:
+ * work[(group * vectorSize + i) * def_biquadgroup + lane]. Coefficients and state of the current group
+ * and section are copied into fixed size local arrays for the duration of the block.
+ */
+void BiquadBank::run() {
+	const unsigned int G = def_biquadgroup;
+	unsigned int width = groups * G;
+	for(unsigned int g = 0; g < groups; g++) {
+		double *block = &work[g * vectorSize * G];
+		for(unsigned int s = 0; s < sections; s++) {
+			double b0[G], b1[G], b2[G], a1[G], a2[G], z1[G], z2[G];
+			double *z = &state[s * 2 * width + g * G];
+			for(unsigned int k = 0; k < G; k++) {
+				b0[k] = coeff(s, 0)[g * G + k];
+				b1[k] = coeff(s, 1)[g * G + k];
+				b2[k] = coeff(s, 2)[g * G + k];
+				a1[k] = coeff(s, 3)[g * G + k];
+				a2[k] = coeff(s, 4)[g * G + k];
+				z1[k] = z[k];
+				z2[k] = z[width + k];
+			}
+			for(unsigned int i = 0; i < vectorSize; i++) {
+				double *x = block + i * G;
+				for(unsigned int k = 0; k < G; k++) {
+					double in = x[k];
+					double out = b0[k] * in + z1[k];
+					z1[k] = b1[k] * in - a1[k] * out + z2[k];
+					z2[k] = b2[k] * in - a2[k] * out;
+					x[k] = out;
+				}
+			}
+			for(unsigned int k = 0; k < G; k++) {
+				z[k] = flushDenormal(z1[k]);
+				z[width + k] = flushDenormal(z2[k]);
+			}
+		}
+	}
+	for(unsigned int l = 0; l < lanes; l++) {
+		const double *src = &work[(l / G) * vectorSize * G + l % G];
+		double *dest = &outputs[l * vectorSize];
+		for(unsigned int i = 0; i < vectorSize; i++)
+			dest[i] = src[i * G];
+	}
+	std::copy(outputs.begin(), outputs.begin() + vectorSize, vector.begin());
+}
+
+const AudioBuffer &BiquadBank::process(const AudioBuffer *const *signals) {
+	const unsigned int G = def_biquadgroup;
+	bool inputSilent = true;
+	for(unsigned int l = 0; l < lanes && inputSilent; l++)
+		inputSilent = signals[l]->isSilent();
+	if(sleep(inputSilent))
+		return *this;
+	for(unsigned int l = 0; l < lanes; l++) {
+		const double *src = signals[l]->getVector();
+		double *dest = &work[(l / G) * vectorSize * G + l % G];
+		for(unsigned int i = 0; i < vectorSize; i++)
+			dest[i * G] = src[i];
+	}
+	run();
+	return *this;
+}
+
+const AudioBuffer &BiquadBank::process(const AudioBuffer &signal) {
+	const unsigned int G = def_biquadgroup;
+	if(sleep(signal.isSilent()))
+		return *this;
+	const double *src = signal.getVector();
+	for(unsigned int l = 0; l < lanes; l++) {
+		double *dest = &work[(l / G) * vectorSize * G + l % G];
+		for(unsigned int i = 0; i < vectorSize; i++)
+			dest[i * G] = src[i];
+	}
+	run();
+	return *this;
+}
@@ -0,0 +1,106 @@
+/*
+ * Biquad.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef BIQUAD_H_
+#define BIQUAD_H_
+
+#include "AudioBase.h"
+#include "Silence.h"
+#include <vector>
+
+/**
+ * Number of lanes filtered together. Lanes are padded to a multiple of this, and each group's state is
+ * held in local arrays of this width so the compiler can keep it in vector registers.
+ */
+const unsigned int def_biquadgroup = 4;
+
+/**
+ * Bank of independent biquad cascades, one per lane (a channel or a voice), processed together.
+ *
+ * Every lane runs the same number of second order sections in series, in transposed direct form II,
+ * which keeps rounding noise low when poles are close to the unit circle. Coefficients and state are
+ * stored section by section with lanes contiguous, and lanes are processed in groups of
+ * `def_biquadgroup` so the per-sample arithmetic of a group vectorizes across lanes.
+ *
+ * Lane 0 is output in this buffer's own vector; all lanes are available through getLane().
+ */
+class BiquadBank : public AudioBuffer {
+protected:
+	unsigned int lanes;
+	unsigned int sections;
+	unsigned int groups;
+	std::vector<double> coeffs;
+	std::vector<double> state;
+	std::vector<double> work;
+	std::vector<double> outputs;
+
+	double *coeff(unsigned int section, unsigned int k) { return &coeffs[(section * 5 + k) * groups * def_biquadgroup]; }
+	void checkLane(int lane);
+	void setSection(int lane, unsigned int section, const double *c);
+	void setButterworth(double cutOff, unsigned int order, int lane, bool highPass);
+	bool sleep(bool inputSilent);
+	void run();
+
+public:
+	/**
+	 * @param lanes Number of independent filters.
+	 * @param sections Number of cascaded biquad sections per lane. A Butterworth filter of order N
+	 * needs (N + 1) / 2 sections.
+	 */
+	BiquadBank(unsigned int lanes, unsigned int sections = 1);
+
+	virtual ~BiquadBank() {}
+
+	/**
+	 * Sets the coefficients of one section, normalized so that a0 is 1:
+	 * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2].
+	 * @param lane Lane to set, or -1 for every lane.
+	 */
+	void setCoefficients(int lane, unsigned int section, double b0, double b1, double b2, double a1, double a2);
+
+	/**
+	 * Designs a Butterworth low pass of the given order as a cascade of sections. Sections not needed by
+	 * the design pass the signal unchanged.
+	 * @param lane Lane to set, or -1 for every lane.
+	 */
+	void setButterworthLP(double cutOff, unsigned int order, int lane = -1);
+
+	/**
+	 * Designs a Butterworth high pass of the given order. See setButterworthLP().
+	 */
+	void setButterworthHP(double cutOff, unsigned int order, int lane = -1);
+
+	/**
+	 * Clears the filter memory of every lane.
+	 */
+	void reset();
+
+	unsigned int getLanes() const { return lanes; }
+
+	unsigned int getSections() const { return sections; }
+
+	/**
+	 * Output of a lane from the last process() call.
+	 */
+	const double *getLane(unsigned int lane) const { return &outputs[lane * vectorSize]; }
+
+	/**
+	 * Filters one input per lane. `signals` must hold getLanes() buffers.
+	 */
+	const AudioBuffer &process(const AudioBuffer *const *signals);
+
+	/**
+	 * Filters the same input through every lane.
+	 */
+	const AudioBuffer &process(const AudioBuffer &signal);
+
+	const AudioBuffer &operator()(const AudioBuffer *const *signals) { return process(signals); }
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+#endif /* BIQUAD_H_ */
@@ -0,0 +1,100 @@
+/*
+ * Convolver.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "Convolver.h"
+#include <algorithm>
+#include <cstring>
+
+Convolver::Convolver(const SampleTable &impulse, int channel, double gain, long maxLength) :
+		fft(transformSize(vectorSize)), block(vectorSize), bins(fft.getBins()), partitions(0), current(0) {
+	std::vector<double> ir = impulse.getSampleTable(channel);
+	long length = (long) ir.size();
+	if(maxLength > 0 && maxLength < length)
+		length = maxLength;
+	init(ir.empty() ? NULL : &ir[0], length, gain);
+}
+
+Convolver::Convolver(const std::vector<double> &impulse, double gain) :
+		fft(transformSize(vectorSize)), block(vectorSize), bins(fft.getBins()), partitions(0), current(0) {
+	init(impulse.empty() ? NULL : &impulse[0], (long) impulse.size(), gain);
+}
+
+/**
+ * Smallest power of two transform that holds a block of input plus a partition of the impulse response.
+ */
+unsigned int Convolver::transformSize(unsigned int block) {
+	unsigned int size = 4;
+	while(size < 2 * block)
+		size <<= 1;
+	return size;
+}
+
+void Convolver::init(const double *ir, long length, double gain) {
+	unsigned int size = fft.getSize();
+	partitions = std::max(1L, (length + block - 1) / block);
+	irRe.assign(partitions * bins, 0.0);
+	irIm.assign(partitions * bins, 0.0);
+	fdlRe.assign(partitions * bins, 0.0);
+	fdlIm.assign(partitions * bins, 0.0);
+	accRe.assign(bins, 0.0);
+	accIm.assign(bins, 0.0);
+	history.assign(size, 0.0);
+	output.assign(size, 0.0);
+
+	std::vector<double> segment(size, 0.0);
+	for(unsigned int p = 0; p < partitions; p++) {
+		std::fill(segment.begin(), segment.end(), 0.0);
+		long first = (long) p * block;
+		long count = std::min((long) block, length - first);
+		for(long i = 0; i < count; i++)
+			segment[i] = gain * ir[first + i];
+		fft.forward(&segment[0], &irRe[p * bins], &irIm[p * bins]);
+	}
+}
+
+void Convolver::reset() {
+	std::fill(fdlRe.begin(), fdlRe.end(), 0.0);
+	std::fill(fdlIm.begin(), fdlIm.end(), 0.0);
+	std::fill(history.begin(), history.end(), 0.0);
+	current = 0;
+}
+
+const AudioBuffer &Convolver::process(const AudioBuffer &signal) {
+	unsigned int size = fft.getSize();
+	if(silence.update(signal.isSilent(), getTailLength())) {
+		if(!silent) {
+			reset();
+			setSilence();
+		}
+		return *this;
+	}
+	silent = false;
+
+	// Slide the input window by one block and transform it into the newest delay line slot.
+	memmove(&history[0], &history[block], (size - block) * sizeof(double));
+	memcpy(&history[size - block], signal.getVector(), block * sizeof(double));
+	fft.forward(&history[0], &fdlRe[current * bins], &fdlIm[current * bins]);
+
+	double *ar = &accRe[0], *ai = &accIm[0];
+	std::fill(accRe.begin(), accRe.end(), 0.0);
+	std::fill(accIm.begin(), accIm.end(), 0.0);
+	for(unsigned int p = 0; p < partitions; p++) {
+		unsigned int slot = (current + partitions - p) % partitions;
+		const double *xr = &fdlRe[slot * bins], *xi = &fdlIm[slot * bins];
+		const double *hr = &irRe[p * bins], *hi = &irIm[p * bins];
+		for(unsigned int k = 0; k < bins; k++) {
+			ar[k] += xr[k] * hr[k] - xi[k] * hi[k];
+			ai[k] += xr[k] * hi[k] + xi[k] * hr[k];
+		}
+	}
+	current = (current + 1) % partitions;
+
+	// Overlap-save: only the last block of the circular result is free of wrap around.
+	fft.inverse(ar, ai, &output[0]);
+	memcpy(&vector[0], &output[size - block], block * sizeof(double));
+	return *this;
+}
@@ -0,0 +1,85 @@
+/*
+ * Convolver.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef CONVOLVER_H_
+#define CONVOLVER_H_
+
+#include "AudioBase.h"
+#include "FunctionTable.h"
+#include "FFT.h"
+#include "Silence.h"
+#include <vector>
+
+/**
+ * Convolution with an impulse response, for convolution reverbs, cabinet simulation and long FIR filters.
+ *
+ * Uses uniformly partitioned overlap-save convolution. The impulse response is cut into partitions of
+ * `vectorSize` frames whose spectra are computed once at construction. Each block, the spectrum of the
+ * newest input is pushed into a frequency-domain delay line, multiplied with every partition against the
+ * matching delayed input spectrum, and transformed back once. Output is produced in the same block as its
+ * input, so there is no latency beyond the processing block, and the cost grows linearly with the length
+ * of the impulse response.
+ */
+class Convolver : public AudioBuffer {
+protected:
+	FFT fft;
+	unsigned int block;
+	unsigned int bins;
+	unsigned int partitions;
+	unsigned int current;
+	std::vector<double> irRe;
+	std::vector<double> irIm;
+	std::vector<double> fdlRe;
+	std::vector<double> fdlIm;
+	std::vector<double> accRe;
+	std::vector<double> accIm;
+	std::vector<double> history;
+	std::vector<double> output;
+	SilenceTracker silence;
+
+	static unsigned int transformSize(unsigned int block);
+	void init(const double *ir, long length, double gain);
+
+public:
+	/**
+	 * @param impulse Impulse response. It is used at the engine sample rate as is.
+	 * @param channel Channel of the impulse response to use.
+	 * @param gain Scale factor applied to the impulse response.
+	 * @param maxLength Largest number of frames of the impulse response to use; 0 uses all of it.
+	 */
+	Convolver(const SampleTable &impulse, int channel = 0, double gain = 1.0, long maxLength = 0);
+
+	/**
+	 * @param impulse Impulse response samples, such as FIR filter coefficients.
+	 */
+	Convolver(const std::vector<double> &impulse, double gain = 1.0);
+
+	virtual ~Convolver() {}
+
+	/**
+	 * Clears the delay line, silencing the tail of previous input.
+	 */
+	void reset();
+
+	/**
+	 * Number of `vectorSize` partitions the impulse response was split into.
+	 */
+	unsigned int getPartitions() const { return partitions; }
+
+	/**
+	 * Number of samples of output that follow the last sound in the input. Once the input has been
+	 * marked silent for this long, processing stops and the output is marked silent until sound arrives
+	 * again.
+	 */
+	unsigned long getTailLength() const { return (unsigned long)(partitions + 1) * block; }
+
+	const AudioBuffer &process(const AudioBuffer &signal);
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+#endif /* CONVOLVER_H_ */
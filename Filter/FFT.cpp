@@ -0,0 +1,118 @@
+/*
+ * FFT.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "FFT.h"
+#include "AudioBase.h"
+#include "AudioException.h"
+#include <cmath>
+#include <cstdlib>
+
+FFT::FFT(unsigned int size) : size(size), half(size / 2) {
+	if(size < 4 || (size & (size - 1)) != 0) {
+		AudioException exception;
+		exception.setError(SIZE_MISMATCH, "FFT size must be a power of two", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+
+	unsigned int bits = 0;
+	while((1u << bits) < half)
+		bits++;
+	bitReverse.resize(half);
+	for(unsigned int i = 0; i < half; i++) {
+		unsigned int r = 0;
+		for(unsigned int b = 0; b < bits; b++)
+			r |= ((i >> b) & 1) << (bits - 1 - b);
+		bitReverse[i] = r;
+	}
+
+	// Twiddles of the half size complex transform, exp(-2 pi i k / half).
+	twiddleRe.resize(half / 2);
+	twiddleIm.resize(half / 2);
+	for(unsigned int k = 0; k < half / 2; k++) {
+		twiddleRe[k] = cos(TWOPI * k / half);
+		twiddleIm[k] = -sin(TWOPI * k / half);
+	}
+	// Twiddles of the split step, exp(-2 pi i k / size).
+	splitRe.resize(half + 1);
+	splitIm.resize(half + 1);
+	for(unsigned int k = 0; k <= half; k++) {
+		splitRe[k] = cos(TWOPI * k / size);
+		splitIm[k] = -sin(TWOPI * k / size);
+	}
+	workRe.resize(half);
+	workIm.resize(half);
+}
+
+/**
+ * In-place iterative radix-2 complex transform of `half` points. Input must already be in bit reversed
+ * order. The inverse uses conjugate twiddles and is not scaled.
+ */
+void FFT::transform(double *re, double *im, bool inverse) {
+	double sign = inverse ? -1.0 : 1.0;
+	for(unsigned int len = 2; len <= half; len <<= 1) {
+		unsigned int span = len / 2;
+		unsigned int step = half / len;
+		for(unsigned int start = 0; start < half; start += len) {
+			for(unsigned int j = 0; j < span; j++) {
+				double wr = twiddleRe[j * step];
+				double wi = sign * twiddleIm[j * step];
+				unsigned int a = start + j, b = a + span;
+				double tr = wr * re[b] - wi * im[b];
+				double ti = wr * im[b] + wi * re[b];
+				re[b] = re[a] - tr;
+				im[b] = im[a] - ti;
+				re[a] += tr;
+				im[a] += ti;
+			}
+		}
+	}
+}
+
+void FFT::forward(const double *input, double *re, double *im) {
+	double *zr = &workRe[0], *zi = &workIm[0];
+	// Pack even samples as real parts and odd samples as imaginary parts.
+	for(unsigned int n = 0; n < half; n++) {
+		zr[bitReverse[n]] = input[2 * n];
+		zi[bitReverse[n]] = input[2 * n + 1];
+	}
+	transform(zr, zi, false);
+
+	for(unsigned int k = 0; k <= half; k++) {
+		unsigned int a = k % half, b = (half - k) % half;
+		double er = 0.5 * (zr[a] + zr[b]);
+		double ei = 0.5 * (zi[a] - zi[b]);
+		double orr = 0.5 * (zi[a] + zi[b]);
+		double oi = -0.5 * (zr[a] - zr[b]);
+		re[k] = er + splitRe[k] * orr - splitIm[k] * oi;
+		im[k] = ei + splitRe[k] * oi + splitIm[k] * orr;
+	}
+}
+
+void FFT::inverse(const double *re, const double *im, double *output) {
+	double *zr = &workRe[0], *zi = &workIm[0];
+	for(unsigned int k = 0; k < half; k++) {
+		unsigned int m = half - k;
+		double er = 0.5 * (re[k] + re[m]);
+		double ei = 0.5 * (im[k] - im[m]);
+		double dr = 0.5 * (re[k] - re[m]);
+		double di = 0.5 * (im[k] + im[m]);
+		// Odd part: (X[k] - conj(X[half - k])) / 2 rotated by exp(+2 pi i k / size).
+		double orr = dr * splitRe[k] + di * splitIm[k];
+		double oi = di * splitRe[k] - dr * splitIm[k];
+		unsigned int r = bitReverse[k];
+		zr[r] = er - oi;
+		zi[r] = ei + orr;
+	}
+	transform(zr, zi, true);
+
+	double scale = 1.0 / half;
+	for(unsigned int n = 0; n < half; n++) {
+		output[2 * n] = zr[n] * scale;
+		output[2 * n + 1] = zi[n] * scale;
+	}
+}
@@ -0,0 +1,57 @@
+/*
+ * FFT.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef FFT_H_
+#define FFT_H_
+
+#include <vector>
+
+/**
+ * Real-input FFT of a fixed power of two size. A length N real transform is computed as a length N / 2
+ * complex transform followed by a split step. Spectra are stored as separate real and imaginary arrays of
+ * N / 2 + 1 bins, which keeps complex multiply-accumulate loops over spectra vectorizable.
+ */
+class FFT {
+protected:
+	unsigned int size;
+	unsigned int half;
+	std::vector<unsigned int> bitReverse;
+	std::vector<double> twiddleRe;
+	std::vector<double> twiddleIm;
+	std::vector<double> splitRe;
+	std::vector<double> splitIm;
+	std::vector<double> workRe;
+	std::vector<double> workIm;
+
+	void transform(double *re, double *im, bool inverse);
+
+public:
+	/**
+	 * @param size Transform length. Must be a power of two, at least 4.
+	 */
+	FFT(unsigned int size);
+
+	unsigned int getSize() const { return size; }
+
+	/**
+	 * Number of bins in a spectrum, N / 2 + 1.
+	 */
+	unsigned int getBins() const { return half + 1; }
+
+	/**
+	 * Forward transform of `size` real samples into getBins() complex bins. Not normalized.
+	 */
+	void forward(const double *input, double *re, double *im);
+
+	/**
+	 * Inverse transform of getBins() bins into `size` real samples, scaled by 1 / N so that
+	 * inverse(forward(x)) returns x.
+	 */
+	void inverse(const double *re, const double *im, double *output);
+};
+
+#endif /* FFT_H_ */
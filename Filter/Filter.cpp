@@ -5,10 +5,12 @@
  *      Author: Thrifleganger
  */
 #include "Filter.h"
+#include "Denormal.h"
 #include <cmath>
+#include <algorithm>
 
 const AudioBuffer &FirstOrderFilter::process(const AudioBuffer &sig, double cutOffFrequency) {
-	signal = sig.getVector();
+	setInput(sig);
 	if(cutOff != cutOffFrequency) {
 		cutOff = cutOffFrequency;
 		update();
@@ -19,7 +21,7 @@ const AudioBuffer &FirstOrderFilter::process(const AudioBuffer &sig, double cutO
 }
 
 const AudioBuffer &FirstOrderFilter::process(const AudioBuffer &sig, const AudioBuffer &cutOffFrequency) {
-	signal = sig.getVector();
+	setInput(sig);
 	cutOffMod = cutOffFrequency.getVector();
 	cutOff = cutOffMod[0];
 	update();
@@ -28,10 +30,25 @@ const AudioBuffer &FirstOrderFilter::process(const AudioBuffer &sig, const Audio
 }
 
 void FirstOrderFilter::checkModulation(int index) {
-	if(cutOffMod != NULL) {
+	if(cutOffMod == NULL)
+		return;
+	if(controlStride <= 1) {
 		cutOff = cutOffMod[index];
 		update();
+		return;
 	}
+	if(index % controlStride == 0) {
+		int n = std::min((int) controlStride, (int) getVectorSize() - index);
+		double startA = coeffA, startB = coeffB;
+		cutOff = cutOffMod[index + n - 1];
+		update();
+		incA = (coeffA - startA) / n;
+		incB = (coeffB - startB) / n;
+		coeffA = startA;
+		coeffB = startB;
+	}
+	coeffA += incA;
+	coeffB += incB;
 }
 
 // ************* Divide by zero error check
@@ -44,11 +61,18 @@ void ToneLP::update() {
 }
 
 void ToneLP::filter() {
+	if(inputSilent && fabs(delSig) < def_silentstate) {
+		delSig = 0.0;
+		setSilence();
+		return;
+	}
+	silent = false;
 	for(unsigned int i = 0; i < getVectorSize(); i++) {
 		checkModulation(i);
 		delSig = coeffA * signal[i] - coeffB * delSig;
 		vector[i] = delSig;
 	}
+	delSig = flushDenormal(delSig);
 }
 
 
@@ -63,17 +87,30 @@ void ToneHP::update() {
 }
 
 void ToneHP::filter() {
+	if(inputSilent && fabs(delSig) < def_silentstate) {
+		delSig = 0.0;
+		setSilence();
+		return;
+	}
+	silent = false;
 	for(unsigned int i = 0; i < getVectorSize(); i++) {
 		checkModulation(i);
 		delSig = coeffA * signal[i] - coeffB * delSig;
 		vector[i] = delSig;
 	}
+	delSig = flushDenormal(delSig);
 }
 
 
 //Second order filter:
 
 void SecondOrderFilter::filter() {
+	if(inputSilent && fabs(delSig[0]) < def_silentstate && fabs(delSig[1]) < def_silentstate) {
+		delSig[0] = delSig[1] = 0.0;
+		setSilence();
+		return;
+	}
+	silent = false;
 	for(unsigned int i = 0; i < getVectorSize(); i++) {
 		checkModulation(i);
 		w = signal[i] -  (coeffB[0] * delSig[0]) - (coeffB[1] * delSig[1]);
@@ -82,19 +119,45 @@ void SecondOrderFilter::filter() {
 		delSig[1] = delSig[0];
 		vector[i] = delSig[0] = w;
 	}
+	// Flush the state once per block so silent tails reach zero instead of going subnormal.
+	delSig[0] = flushDenormal(delSig[0]);
+	delSig[1] = flushDenormal(delSig[1]);
 }
 
 void SecondOrderFilter::checkModulation(int index) {
-	if(cutOffMod != NULL || bwMod != NULL) {
+	if(cutOffMod == NULL && bwMod == NULL)
+		return;
+	if(controlStride <= 1) {
 		cutOff = cutOffMod != NULL ? cutOffMod[index] : cutOff;
 		bandwidth = bwMod != NULL ? bwMod[index] : bandwidth;
 		update();
+		return;
+	}
+	if(index % controlStride == 0) {
+		int n = std::min((int) controlStride, (int) getVectorSize() - index);
+		double startA[3] = { coeffA[0], coeffA[1], coeffA[2] };
+		double startB[2] = { coeffB[0], coeffB[1] };
+		cutOff = cutOffMod != NULL ? cutOffMod[index + n - 1] : cutOff;
+		bandwidth = bwMod != NULL ? bwMod[index + n - 1] : bandwidth;
+		update();
+		for(int k = 0; k < 3; k++) {
+			incA[k] = (coeffA[k] - startA[k]) / n;
+			coeffA[k] = startA[k];
+		}
+		for(int k = 0; k < 2; k++) {
+			incB[k] = (coeffB[k] - startB[k]) / n;
+			coeffB[k] = startB[k];
+		}
 	}
+	for(int k = 0; k < 3; k++)
+		coeffA[k] += incA[k];
+	for(int k = 0; k < 2; k++)
+		coeffB[k] += incB[k];
 }
 
 
 const AudioBuffer &Butterworth::process(const AudioBuffer &sig, double cutOffFrequency) {
-	signal = sig.getVector();
+	setInput(sig);
 	if(cutOff != cutOffFrequency) {
 		cutOff = cutOffFrequency;
 		update();
@@ -105,7 +168,7 @@ const AudioBuffer &Butterworth::process(const AudioBuffer &sig, double cutOffFre
 }
 
 const AudioBuffer &Butterworth::process(const AudioBuffer &sig, const AudioBuffer &cutOffFrequency) {
-	signal = sig.getVector();
+	setInput(sig);
 	cutOffMod = cutOffFrequency.getVector();
 	cutOff = cutOffMod[0];
 	update();
@@ -140,7 +203,7 @@ void ButterHP::update() {
 //////////////////////
 
 const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, double co, double bw) {
-	signal = sig.getVector();
+	setInput(sig);
 	if(cutOff != co || bandwidth != bw) {
 		cutOff = co;
 		bandwidth = bw;
@@ -152,7 +215,7 @@ const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, double co, d
 }
 
 const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, const AudioBuffer &co, double bw) {
-	signal = sig.getVector();
+	setInput(sig);
 	cutOffMod = co.getVector();
 	cutOff = cutOffMod[0];
 	bandwidth = bw;
@@ -162,7 +225,7 @@ const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, const AudioB
 }
 
 const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, double co, const AudioBuffer &bw) {
-	signal = sig.getVector();
+	setInput(sig);
 	cutOff = co;
 	bwMod = bw.getVector();
 	bandwidth = bwMod[0];
@@ -172,7 +235,7 @@ const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, double co, c
 }
 
 const AudioBuffer &ButterworthBand::process(const AudioBuffer &sig, const AudioBuffer &co, const AudioBuffer &bw) {
-	signal = sig.getVector();
+	setInput(sig);
 	cutOffMod = co.getVector();
 	bwMod = bw.getVector();
 	cutOff = cutOffMod[0];
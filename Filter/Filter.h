@@ -9,7 +9,16 @@
 #define FILTER_H_
 
 #include "AudioBase.h"
+#include "Silence.h"
 
+/**
+ * Base for first order filters. When the cutoff is modulated by an AudioBuffer, coefficients are
+ * recomputed every `controlStride` samples from the control value at the end of each sub-block, and
+ * linearly interpolated in between. A stride of 1 (the default) recomputes them every sample.
+ *
+ * While the input is marked silent and the filter memory has decayed below `def_silentstate`, filtering is
+ * skipped and the output is marked silent.
+ */
 class FirstOrderFilter : public AudioBuffer {
 
 protected:
@@ -20,6 +29,15 @@ protected:
 	double delSig;
 	const double *signal;
 	const double *cutOffMod;
+	unsigned int controlStride;
+	double incA;
+	double incB;
+	bool inputSilent;
+
+	void setInput(const AudioBuffer &sig) {
+		signal = sig.getVector();
+		inputSilent = sig.isSilent();
+	}
 
 	virtual void filter() = 0;
 	virtual void update() = 0;
@@ -27,10 +45,17 @@ protected:
 
 public:
 	FirstOrderFilter(double cutOff) : coeffA(0.0), coeffB(0.0), rc(0.0), cutOff(cutOff), delSig(0.0),
-		signal(NULL), cutOffMod(NULL) {}
+		signal(NULL), cutOffMod(NULL), controlStride(1), incA(0.0), incB(0.0), inputSilent(false) {}
 
 	virtual ~FirstOrderFilter() {}
 
+	/**
+	 * Number of samples between coefficient updates when the cutoff is modulated.
+	 */
+	void setControlStride(unsigned int stride) { controlStride = stride > 0 ? stride : 1; }
+
+	unsigned int getControlStride() const { return controlStride; }
+
 	virtual const AudioBuffer &process(const AudioBuffer &signal, double cutOffFrequency);
 
 	virtual const AudioBuffer &process(const AudioBuffer &signal, const AudioBuffer &cutOffFrequency);
@@ -65,6 +90,11 @@ public:
 };
 
 
+/**
+ * Base for second order filters. Modulated cutoff and bandwidth follow the same control-rate scheme as
+ * FirstOrderFilter: with a stride above 1, update() runs once per sub-block and the five coefficients
+ * are linearly interpolated across it. Silent input is skipped as in FirstOrderFilter.
+ */
 class SecondOrderFilter : public AudioBuffer {
 
 protected:
@@ -80,6 +110,15 @@ protected:
 	const double *signal;
 	const double *cutOffMod;
 	const double *bwMod;
+	unsigned int controlStride;
+	double incA[3];
+	double incB[2];
+	bool inputSilent;
+
+	void setInput(const AudioBuffer &sig) {
+		signal = sig.getVector();
+		inputSilent = sig.isSilent();
+	}
 
 	virtual void filter();
 	virtual void update() = 0;
@@ -87,16 +126,25 @@ protected:
 
 public:
 	SecondOrderFilter() : coeffA(new double[10]), coeffB(new double[10]), L(0), M(0), w(0), y(0),
-		cutOff(0), bandwidth(0), delSig(new double[10]), signal(NULL), cutOffMod(NULL), bwMod(NULL) { }
+		cutOff(0), bandwidth(0), delSig(new double[10]), signal(NULL), cutOffMod(NULL), bwMod(NULL),
+		controlStride(1), incA(), incB(), inputSilent(false) { }
 
 	SecondOrderFilter(double co, double bw) : coeffA(new double[10]), coeffB(new double[10]), L(0), M(0), w(0), y(0),
-		cutOff(co), bandwidth(bw), delSig(new double[10]), signal(NULL), cutOffMod(NULL), bwMod(NULL) { }
+		cutOff(co), bandwidth(bw), delSig(new double[10]), signal(NULL), cutOffMod(NULL), bwMod(NULL),
+		controlStride(1), incA(), incB(), inputSilent(false) { }
 
 	virtual ~SecondOrderFilter() {
 		delete[] coeffA;
 		delete[] coeffB;
 		delete[] delSig;
 	}
+
+	/**
+	 * Number of samples between coefficient updates when cutoff or bandwidth is modulated.
+	 */
+	void setControlStride(unsigned int stride) { controlStride = stride > 0 ? stride : 1; }
+
+	unsigned int getControlStride() const { return controlStride; }
 };
 
 class Butterworth : public SecondOrderFilter {
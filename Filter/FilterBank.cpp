@@ -0,0 +1,142 @@
+/*
+ * FilterBank.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "FilterBank.h"
+#include "Denormal.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+FilterBank::FilterBank(unsigned int bands) :
+		bands(bands), width((bands + def_biquadgroup - 1) / def_biquadgroup * def_biquadgroup),
+		centres(bands, 0.0), bandwidths(bands, 0.0), a0(width, 0.0), b0(width, 0.0), b1(width, 0.0),
+		z1(width, 0.0), z2(width, 0.0), env(width, 0.0), outputs(bands * vectorSize, 0.0),
+		envelopes(bands * vectorSize, 0.0), follow(false), attack(0.0), release(0.0) {
+	if(bands == 0) {
+		exception.setError(ZERO_VALUE, "Filter bank needs at least one band", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+}
+
+void FilterBank::checkBand(unsigned int band) {
+	if(band >= bands) {
+		exception.setError(SIZE_MISMATCH, "Band index out of range", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+}
+
+/**
+ * Same design as ButterBP::update(). The feed forward coefficients are a0, 0 and -a0.
+ */
+void FilterBank::setBand(unsigned int band, double centre, double bandwidth) {
+	checkBand(band);
+	centres[band] = centre;
+	bandwidths[band] = bandwidth;
+	double M = 1.0 / tan(PI * bandwidth / getSrate());
+	a0[band] = 1.0 / (1.0 + M);
+	b0[band] = -2.0 * M * cos(TWOPI * centre / getSrate()) * a0[band];
+	b1[band] = (M - 1.0) * a0[band];
+}
+
+void FilterBank::setLogSpacing(double lowest, double highest) {
+	double ratio = bands > 1 ? pow(highest / lowest, 1.0 / (bands - 1)) : 2.0;
+	double spread = sqrt(ratio) - 1.0 / sqrt(ratio);
+	for(unsigned int b = 0; b < bands; b++) {
+		double centre = lowest * pow(ratio, (double) b);
+		setBand(b, centre, centre * spread);
+	}
+}
+
+void FilterBank::setEnvelopeFollower(double attack, double release) {
+	follow = true;
+	this->attack = attack > 0 ? exp(-1.0 / (attack * getSrate())) : 0.0;
+	this->release = release > 0 ? exp(-1.0 / (release * getSrate())) : 0.0;
+}
+
+void FilterBank::reset() {
+	std::fill(z1.begin(), z1.end(), 0.0);
+	std::fill(z2.begin(), z2.end(), 0.0);
+	std::fill(env.begin(), env.end(), 0.0);
+}
+
+/**
+ * Bands are processed `def_biquadgroup` at a time. Within a group each input sample is read once and
+ * fed to every band of the group from local arrays, so the state stays in registers for the block.
+ */
+const AudioBuffer &FilterBank::process(const AudioBuffer &signal) {
+	const unsigned int G = def_biquadgroup;
+	const double *in = signal.getVector();
+	if(signal.isSilent()) {
+		if(silent)
+			return *this;
+		bool decayed = true;
+		for(unsigned int k = 0; k < width && decayed; k++)
+			decayed = fabs(z1[k]) < def_silentstate && fabs(z2[k]) < def_silentstate && fabs(env[k]) < def_silentstate;
+		if(decayed) {
+			// Filters and followers have died away: clear them and skip work until the input returns.
+			reset();
+			std::fill(outputs.begin(), outputs.end(), 0.0);
+			std::fill(envelopes.begin(), envelopes.end(), 0.0);
+			setSilence();
+			return *this;
+		}
+	}
+	silent = false;
+	std::fill(vector.begin(), vector.end(), 0.0);
+
+	for(unsigned int g = 0; g < width; g += G) {
+		double A[G], B0[G], B1[G], s1[G], s2[G], e[G];
+		double *dest[G], *envDest[G];
+		unsigned int used = std::min(G, bands - g);
+		for(unsigned int k = 0; k < G; k++) {
+			A[k] = a0[g + k];
+			B0[k] = b0[g + k];
+			B1[k] = b1[g + k];
+			s1[k] = z1[g + k];
+			s2[k] = z2[g + k];
+			e[k] = env[g + k];
+			// Padding bands have zero coefficients and their outputs are never stored.
+			dest[k] = k < used ? &outputs[(g + k) * vectorSize] : NULL;
+			envDest[k] = k < used ? &envelopes[(g + k) * vectorSize] : NULL;
+		}
+
+		for(unsigned int i = 0; i < vectorSize; i++) {
+			double x = in[i];
+			double y[G];
+			for(unsigned int k = 0; k < G; k++) {
+				// Transposed direct form II.
+				y[k] = A[k] * x + s1[k];
+				s1[k] = s2[k] - B0[k] * y[k];
+				s2[k] = -A[k] * x - B1[k] * y[k];
+			}
+			if(follow) {
+				for(unsigned int k = 0; k < G; k++) {
+					double level = fabs(y[k]);
+					double coeff = level > e[k] ? attack : release;
+					e[k] = level + coeff * (e[k] - level);
+				}
+				for(unsigned int k = 0; k < used; k++)
+					envDest[k][i] = e[k];
+			}
+			double sum = 0.0;
+			for(unsigned int k = 0; k < used; k++) {
+				dest[k][i] = y[k];
+				sum += y[k];
+			}
+			vector[i] += sum;
+		}
+
+		for(unsigned int k = 0; k < G; k++) {
+			z1[g + k] = flushDenormal(s1[k]);
+			z2[g + k] = flushDenormal(s2[k]);
+			env[g + k] = flushDenormal(e[k]);
+		}
+	}
+	return *this;
+}
@@ -0,0 +1,99 @@
+/*
+ * FilterBank.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef FILTERBANK_H_
+#define FILTERBANK_H_
+
+#include "AudioBase.h"
+#include "Biquad.h"
+#include "Silence.h"
+#include <vector>
+
+/**
+ * Bank of band pass filters sharing one input, for vocoders and analyzers. Each band is a Butterworth
+ * band pass with the same response as ButterBP. Band coefficients and state are stored one array per
+ * coefficient, and bands are processed in groups of `def_biquadgroup` against a single read of the input,
+ * so the arithmetic vectorizes across bands.
+ *
+ * Band outputs are planar (see getBand()). Optionally each band also runs a peak envelope follower
+ * (see getEnvelope()). The bank's own vector holds the sum of all bands.
+ */
+class FilterBank : public AudioBuffer {
+protected:
+	unsigned int bands;
+	unsigned int width;
+	std::vector<double> centres;
+	std::vector<double> bandwidths;
+	std::vector<double> a0;
+	std::vector<double> b0;
+	std::vector<double> b1;
+	std::vector<double> z1;
+	std::vector<double> z2;
+	std::vector<double> env;
+	std::vector<double> outputs;
+	std::vector<double> envelopes;
+	bool follow;
+	double attack;
+	double release;
+
+	void checkBand(unsigned int band);
+
+public:
+	/**
+	 * @param bands Number of bands. Bands pass nothing until set with setBand() or setLogSpacing().
+	 */
+	FilterBank(unsigned int bands);
+
+	virtual ~FilterBank() {}
+
+	/**
+	 * Sets the centre frequency and bandwidth of one band, both in Hz.
+	 */
+	void setBand(unsigned int band, double centre, double bandwidth);
+
+	/**
+	 * Spaces the bands logarithmically from `lowest` to `highest` centre frequency, with bandwidths chosen
+	 * so that neighbouring bands cross at their -3 dB points.
+	 */
+	void setLogSpacing(double lowest, double highest);
+
+	/**
+	 * Enables per-band envelope followers.
+	 * @param attack Time in seconds for the envelope to rise by 1 - 1/e towards a louder input.
+	 * @param release Time in seconds for the envelope to fall by 1 - 1/e towards a quieter input.
+	 */
+	void setEnvelopeFollower(double attack, double release);
+
+	void disableEnvelopeFollower() { follow = false; }
+
+	/**
+	 * Clears filter and envelope state.
+	 */
+	void reset();
+
+	unsigned int getBands() const { return bands; }
+
+	double getCentre(unsigned int band) const { return centres[band]; }
+
+	double getBandwidth(unsigned int band) const { return bandwidths[band]; }
+
+	/**
+	 * Output of a band from the last process() call.
+	 */
+	const double *getBand(unsigned int band) const { return &outputs[band * vectorSize]; }
+
+	/**
+	 * Envelope of a band from the last process() call. Only updated while the followers are enabled.
+	 */
+	const double *getEnvelope(unsigned int band) const { return &envelopes[band * vectorSize]; }
+
+	const AudioBuffer &process(const AudioBuffer &signal);
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+#endif /* FILTERBANK_H_ */
@@ -0,0 +1,221 @@
+/*
+ * BlockCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "BlockCache.h"
+#include <sndfile.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+BlockCache::BlockCache(size_t capacity) : capacity(capacity), used(0), hits(0), misses(0), evictions(0) {}
+
+std::shared_ptr<const BlockCache::Block> BlockCache::find(unsigned long source, long index, bool count) {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::unordered_map<Key, Entry, KeyHash>::iterator it = entries.find(Key(source, index));
+	if(it == entries.end()) {
+		if(count)
+			misses++;
+		return std::shared_ptr<const Block>();
+	}
+	if(count)
+		hits++;
+	order.splice(order.begin(), order, it->second.position);
+	return it->second.block;
+}
+
+void BlockCache::insert(unsigned long source, long index, const std::shared_ptr<const Block> &block) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Key key(source, index);
+	if(entries.find(key) != entries.end())
+		return;
+
+	size_t bytes = blockBytes(*block);
+	while(!order.empty() && used + bytes > capacity) {
+		std::unordered_map<Key, Entry, KeyHash>::iterator victim = entries.find(order.back());
+		used -= blockBytes(*victim->second.block);
+		entries.erase(victim);
+		order.pop_back();
+		evictions++;
+	}
+
+	order.push_front(key);
+	Entry entry = { block, order.begin() };
+	entries[key] = entry;
+	used += bytes;
+}
+
+void BlockCache::release(unsigned long source) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Order::iterator it = order.begin();
+	while(it != order.end()) {
+		if(it->first == source) {
+			std::unordered_map<Key, Entry, KeyHash>::iterator entry = entries.find(*it);
+			used -= blockBytes(*entry->second.block);
+			entries.erase(entry);
+			it = order.erase(it);
+		} else
+			++it;
+	}
+}
+
+size_t BlockCache::getMemoryUsage() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return used;
+}
+
+size_t BlockCache::getBlockCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries.size();
+}
+
+double BlockCache::getHitRate() const {
+	unsigned long lookups = hits + misses;
+	return lookups > 0 ? (double) hits / lookups : 0.0;
+}
+
+void BlockCache::printStatistics() const {
+	std::cout << "Blocks: " << getBlockCount() << std::endl;
+	std::cout << "Memory (bytes): " << getMemoryUsage() << " of " << capacity << std::endl;
+	std::cout << "Hits: " << hits << ", misses: " << misses << ", evictions: " << evictions << std::endl;
+	std::cout << "Hit rate: " << getHitRate() << std::endl;
+}
+
+namespace {
+
+std::atomic<unsigned long> nextSourceId(1);
+
+}
+
+CachedSample::CachedSample(const char *fileName, BlockCache &cache, long blockFrames) :
+		fileName(fileName), decoderUses(0), id(nextSourceId++), cache(cache), channels(0), samplerate(0),
+		frames(0), blockFrames(blockFrames) {
+
+	SF_INFO info;
+	SNDFILE *openFile = sf_open(fileName, SFM_READ, &info);
+	if(openFile == NULL || blockFrames <= 0) {
+		exception.setError(OPEN_FILE_TO_READ, fileName, DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+	decoders.reserve(def_cachedecoders);
+	Decoder decoder = { openFile, 0, 0 };
+	decoders.push_back(decoder);
+	channels = info.channels;
+	samplerate = info.samplerate;
+	frames = (long) info.frames;
+	readBuffer.resize(blockFrames * channels);
+}
+
+CachedSample::~CachedSample() {
+	cache.release(id);
+	for(unsigned int i = 0; i < decoders.size(); i++)
+		sf_close((SNDFILE *) decoders[i].file);
+}
+
+/**
+ * Returns a decoder positioned at `frame`, or one whose position is negative if the file could not be
+ * positioned there. Prefers the decoder closest before `frame` within one block and decodes forward from
+ * it. Otherwise opens another decoder while fewer than `def_cachedecoders` are open, or takes the least
+ * recently used one, and seeks.
+ */
+CachedSample::Decoder *CachedSample::getDecoder(long frame) {
+	Decoder *decoder = NULL;
+	for(unsigned int i = 0; i < decoders.size(); i++) {
+		long position = decoders[i].position;
+		if(position >= 0 && position <= frame && frame - position <= blockFrames &&
+				(decoder == NULL || position > decoder->position))
+			decoder = &decoders[i];
+	}
+
+	if(decoder == NULL) {
+		if(decoders.size() < def_cachedecoders) {
+			SF_INFO info;
+			SNDFILE *openFile = sf_open(fileName.c_str(), SFM_READ, &info);
+			if(openFile != NULL) {
+				Decoder opened = { openFile, 0, 0 };
+				decoders.push_back(opened);
+				decoder = &decoders.back();
+			}
+		}
+		if(decoder == NULL) {
+			decoder = &decoders[0];
+			for(unsigned int i = 1; i < decoders.size(); i++)
+				if(decoders[i].lastUse < decoder->lastUse)
+					decoder = &decoders[i];
+		}
+		if(decoder->position < 0 || decoder->position > frame || frame - decoder->position > blockFrames)
+			decoder->position = sf_seek((SNDFILE *) decoder->file, frame, SEEK_SET) == frame ? frame : -1;
+	}
+	decoder->lastUse = ++decoderUses;
+
+	while(decoder->position >= 0 && decoder->position < frame) {
+		long skipped = sf_readf_double((SNDFILE *) decoder->file, &readBuffer[0],
+				std::min(blockFrames, frame - decoder->position));
+		decoder->position = skipped > 0 ? decoder->position + skipped : -1;
+	}
+	return decoder;
+}
+
+/**
+ * Returns a decoded block, decoding it into the cache on a miss. Readers that miss the same block at once
+ * queue on the file lock; the cache is checked again under it, so only the first of them decodes.
+ */
+std::shared_ptr<const BlockCache::Block> CachedSample::getBlock(long index) {
+	std::shared_ptr<const BlockCache::Block> block = cache.find(id, index);
+	if(block)
+		return block;
+
+	std::lock_guard<std::mutex> lock(fileMutex);
+	block = cache.find(id, index, false);
+	if(block)
+		return block;
+
+	std::shared_ptr<BlockCache::Block> decoded = std::make_shared<BlockCache::Block>();
+	long first = index * blockFrames;
+	long wanted = std::min(blockFrames, frames - first);
+	long framesRead = 0;
+	Decoder *decoder = getDecoder(first);
+	if(decoder->position == first)
+		framesRead = sf_readf_double((SNDFILE *) decoder->file, &readBuffer[0], wanted);
+	framesRead = std::max(framesRead, 0L);
+	decoder->position = framesRead == wanted ? first + framesRead : -1;
+
+	decoded->frames = framesRead;
+	decoded->data.resize(blockFrames * channels, 0.0);
+	for(int c = 0; c < channels; c++) {
+		double *plane = &decoded->data[c * blockFrames];
+		for(long i = 0; i < framesRead; i++)
+			plane[i] = readBuffer[i * channels + c];
+	}
+	if(framesRead < wanted) {
+		setError(UNDEFINED_ERROR, "Could not decode frames " + std::to_string(first) + " to " +
+				std::to_string(first + wanted) + " of " + fileName, DEBUG_INFO);
+		return decoded;
+	}
+	cache.insert(id, index, decoded);
+	return decoded;
+}
+
+const double *CachedSample::readWindow(long start, long count, int channel, double *scratch) {
+	long frame = start, end = start + count, run;
+	while(frame < end) {
+		double *dest = scratch + (frame - start);
+		if(frame >= frames) {
+			memset(dest, 0, (end - frame) * sizeof(double));
+			break;
+		}
+		long index = frame / blockFrames;
+		long offset = frame - index * blockFrames;
+		run = std::min(blockFrames - offset, end - frame);
+		std::shared_ptr<const BlockCache::Block> block = getBlock(index);
+		memcpy(dest, &block->data[channel * blockFrames + offset], run * sizeof(double));
+		frame += run;
+	}
+	return scratch;
+}
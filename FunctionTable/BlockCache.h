@@ -0,0 +1,175 @@
+/*
+ * BlockCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef BLOCKCACHE_H_
+#define BLOCKCACHE_H_
+
+#include "FunctionTable.h"
+#include "AudioException.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <string>
+
+/**
+ * Default number of frames in a decoded cache block.
+ */
+const long def_cacheblock = 8192;
+/**
+ * Default memory budget of a BlockCache in bytes.
+ */
+const size_t def_cachebytes = 64 * 1024 * 1024;
+/**
+ * Largest number of decoders a CachedSample keeps open on its file.
+ */
+const unsigned int def_cachedecoders = 4;
+
+/**
+ * Bounded memory cache of decoded sample blocks, shared by any number of CachedSample sources. When the
+ * budget is exceeded the least recently used blocks are evicted. Safe to use from several threads.
+ */
+class BlockCache {
+public:
+	/**
+	 * Decoded block: `frames` frames of every channel, one plane per channel.
+	 */
+	struct Block {
+		long frames;
+		std::vector<double> data;
+	};
+
+protected:
+	typedef std::pair<unsigned long, long> Key;
+	typedef std::list<Key> Order;
+
+	struct KeyHash {
+		size_t operator()(const Key &key) const {
+			return std::hash<unsigned long>()(key.first) * 31 + std::hash<long>()(key.second);
+		}
+	};
+
+	struct Entry {
+		std::shared_ptr<const Block> block;
+		Order::iterator position;
+	};
+
+	size_t capacity;
+	size_t used;
+	Order order;
+	std::unordered_map<Key, Entry, KeyHash> entries;
+	mutable std::mutex mutex;
+
+	std::atomic<unsigned long> hits;
+	std::atomic<unsigned long> misses;
+	std::atomic<unsigned long> evictions;
+
+	static size_t blockBytes(const Block &block) { return block.data.capacity() * sizeof(double); }
+
+public:
+	/**
+	 * @param capacity Memory budget for decoded blocks, in bytes.
+	 */
+	BlockCache(size_t capacity = def_cachebytes);
+
+	/**
+	 * Looks up block `index` of source `source`. Returns NULL on a miss. The returned block stays valid
+	 * while it is referenced, even if it is evicted meanwhile.
+	 * @param count False for a second look after a counted miss, so one request is not counted twice.
+	 */
+	std::shared_ptr<const Block> find(unsigned long source, long index, bool count = true);
+
+	/**
+	 * Adds a decoded block, evicting least recently used blocks as needed.
+	 */
+	void insert(unsigned long source, long index, const std::shared_ptr<const Block> &block);
+
+	/**
+	 * Drops every block of a source.
+	 */
+	void release(unsigned long source);
+
+	size_t getCapacity() const { return capacity; }
+	size_t getMemoryUsage() const;
+	size_t getBlockCount() const;
+	unsigned long getHits() const { return hits; }
+	unsigned long getMisses() const { return misses; }
+	unsigned long getEvictions() const { return evictions; }
+
+	/**
+	 * Fraction of lookups that were hits.
+	 */
+	double getHitRate() const;
+
+	/**
+	 * Print cache statistics to the console.
+	 */
+	void printStatistics() const;
+};
+
+/**
+ * Sample source for compressed files (FLAC, Ogg and anything else libsndfile decodes). Nothing is decoded
+ * up front: blocks of `blockFrames` are decoded on demand into a shared BlockCache, so files stay
+ * compressed on disk and in memory and only the regions being played are expanded.
+ *
+ * Random access goes through libsndfile's seeking, which uses the format's own seek points (FLAC seek
+ * tables, Ogg page granule positions) but may still decode from a distant sync point. To avoid most
+ * seeks the source keeps up to `def_cachedecoders` decoders open on the file, and indexes them by the
+ * frame each one has reached as blocks are decoded. A miss is decoded by the decoder at or within one
+ * block before it, reading forward; a seek is only made when there is none. Readers playing different
+ * regions of the file thus each keep a decoder that runs in order.
+ *
+ * A block that cannot be read in full is not cached: it reads as silence, the error is set, and the
+ * next request for it tries again.
+ */
+class CachedSample : public AudioException, public SampleSource {
+protected:
+	/**
+	 * Open decoder and the frame it will decode next. A negative position is unknown and needs a seek.
+	 */
+	struct Decoder {
+		void *file;
+		long position;
+		unsigned long lastUse;
+	};
+
+	std::string fileName;
+	std::vector<Decoder> decoders;
+	unsigned long decoderUses;
+	unsigned long id;
+	BlockCache &cache;
+	int channels;
+	double samplerate;
+	long frames;
+	long blockFrames;
+	std::vector<double> readBuffer;
+	std::mutex fileMutex;
+	AudioException exception;
+
+	Decoder *getDecoder(long frame);
+	std::shared_ptr<const BlockCache::Block> getBlock(long index);
+
+public:
+	/**
+	 * @param fileName File to play.
+	 * @param cache Cache holding decoded blocks. Must outlive this source.
+	 * @param blockFrames Size of a decoded block in frames.
+	 */
+	CachedSample(const char *fileName, BlockCache &cache, long blockFrames = def_cacheblock);
+
+	~CachedSample();
+
+	int getChannels() { return channels; }
+	double getSampleRate() { return samplerate; }
+	long getFrames() { return frames; }
+
+	const double *readWindow(long start, long count, int channel, double *scratch);
+};
+
+#endif /* BLOCKCACHE_H_ */
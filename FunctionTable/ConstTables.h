@@ -0,0 +1,153 @@
+/*
+ * ConstTables.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef CONSTTABLES_H_
+#define CONSTTABLES_H_
+
+#include "AudioBase.h"
+#include "FunctionTable.h"
+
+/**
+ * Number of partials used by the precomputed band-limited tables.
+ */
+const unsigned int def_harmonics = 32;
+
+/**
+ * Fixed size table whose contents can be generated at compile time. Like FuncTable, two guard points are
+ * appended after `N` samples for linear and cubic interpolation. Declaring an object of this type as
+ * `constexpr` places the samples in read-only data, so no work is done at program startup.
+ */
+template<unsigned int N>
+struct ConstTable {
+	double table[N + 2];
+
+	constexpr const double *getTable() const { return table; }
+
+	constexpr unsigned int getSize() const { return N; }
+};
+
+namespace ConstGen {
+
+constexpr double pi = 3.14159265358979323846;
+
+/**
+ * Taylor series sine. Accurate to double precision on [0, pi/2]; callers reduce the argument first.
+ */
+constexpr double taylorSin(double x) {
+	double term = x;
+	double sum = x;
+	for(int n = 1; n < 11; n++) {
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+template<unsigned int N>
+constexpr void setGuardPoints(ConstTable<N> &t) {
+	t.table[N] = t.table[0];
+	t.table[N + 1] = t.table[1];
+}
+
+/**
+ * Strength of a partial (0 is the fundamental), following the same rules as FourierTable(harmonics, type).
+ */
+constexpr double partialStrength(unsigned int partial, unsigned int type) {
+	switch(type) {
+	case(SINE) :
+			return partial == 0 ? 1.0 : 0.0;
+	case(SAWTOOTH) :
+			return 1.0 / (double)(partial + 1);
+	case(TRIANGLE) :
+			return partial % 2 == 0 ? 1.0 / (double)((partial + 1) * (partial + 1)) : 0.0;
+	case(SQUARE) :
+			return partial % 2 == 0 ? 1.0 / (double)(partial + 1) : 0.0;
+	default:
+			return 1.0;
+	}
+}
+
+/**
+ * Sum of `harmonics` partials at phase x, given `s` = sin(x) and `c` = cos(x). Each sin(kx) follows from
+ * the one `stride` partials before it by sin((k+d)x) = 2cos(dx)sin(kx) - sin((k-d)x), so no sine is
+ * evaluated per partial. A stride of 2 visits only the odd partials.
+ */
+constexpr double sumPartials(double s, double c, unsigned int harmonics, unsigned int type,
+		unsigned int stride) {
+	const double twoCos = stride == 2 ? 2.0 * (2.0 * c * c - 1.0) : 2.0 * c;
+	double previous = stride == 2 ? -s : 0.0, current = s, sum = 0.0;
+	for(unsigned int partial = 0; partial < harmonics; partial += stride) {
+		sum += partialStrength(partial, type) * current;
+		double next = twoCos * current - previous;
+		previous = current;
+		current = next;
+	}
+	return sum;
+}
+
+} // namespace ConstGen
+
+/**
+ * Generates a single cycle of a sine wave. Same contents as SinTable(N) to within rounding. Only the
+ * first quarter cycle is evaluated; the rest follows by symmetry, which keeps the compile time work
+ * small. `N` must be a multiple of 4.
+ */
+template<unsigned int N>
+constexpr ConstTable<N> makeSinTable() {
+	static_assert(N % 4 == 0, "Table size must be a multiple of 4");
+	ConstTable<N> t{};
+	for(unsigned int i = 1; i <= N / 4; i++) {
+		double y = ConstGen::taylorSin(2 * ConstGen::pi * i / N);
+		t.table[i] = y;
+		t.table[N / 2 - i] = y;
+		t.table[N / 2 + i] = -y;
+		t.table[N - i] = -y;
+	}
+	ConstGen::setGuardPoints(t);
+	return t;
+}
+
+/**
+ * Generates a band-limited table from a sum of harmonics. Partial strengths follow the same rules as
+ * FourierTable(harmonics, type), with zero phase, so the result matches the runtime table of the same size
+ * to within rounding. Every wave is odd, so only the first half cycle is summed; waves of odd partials
+ * only (sine, square, triangle) are also symmetric about a quarter cycle, and only the first quarter is
+ * summed. `N` must be a multiple of 4.
+ * @param harmonics Number of partials.
+ * @param type Any of the wave_type enum values.
+ */
+template<unsigned int N>
+constexpr ConstTable<N> makeFourierTable(unsigned int harmonics, unsigned int type) {
+	static_assert(N % 4 == 0, "Table size must be a multiple of 4");
+	const ConstTable<N> sine = makeSinTable<N>();
+	ConstTable<N> t{};
+	const bool oddPartials = type == SINE || type == SQUARE || type == TRIANGLE;
+	const unsigned int last = oddPartials ? N / 4 : N / 2 - 1;
+	for(unsigned int i = 1; i <= last; i++) {
+		double y = ConstGen::sumPartials(sine.table[i], sine.table[i + N / 4], harmonics, type,
+				oddPartials ? 2 : 1);
+		t.table[i] = y;
+		t.table[N - i] = -y;
+		if(oddPartials) {
+			t.table[N / 2 - i] = y;
+			t.table[N / 2 + i] = -y;
+		}
+	}
+	ConstGen::setGuardPoints(t);
+	return t;
+}
+
+/**
+ * Standard tables of size `def_tsize`, generated at compile time. Defined in FunctionTable.cpp.
+ * The band-limited tables use `def_harmonics` partials.
+ */
+extern const ConstTable<def_tsize> sineTable;
+extern const ConstTable<def_tsize> sawTable;
+extern const ConstTable<def_tsize> squareTable;
+extern const ConstTable<def_tsize> triangleTable;
+
+#endif /* CONSTTABLES_H_ */
@@ -6,17 +6,26 @@
  */
 
 #include "FunctionTable.h"
+#include "ConstTables.h"
+#include "SampleConvert.h"
 #include <sndfile.h>
 #include <vector>
 #include <cmath>
 #include "AudioException.h"
 #include <cstdlib>
 #include <exception>
+#include <algorithm>
+
+constexpr ConstTable<def_tsize> sineTable = makeSinTable<def_tsize>();
+constexpr ConstTable<def_tsize> sawTable = makeFourierTable<def_tsize>(def_harmonics, SAWTOOTH);
+constexpr ConstTable<def_tsize> squareTable = makeFourierTable<def_tsize>(def_harmonics, SQUARE);
+constexpr ConstTable<def_tsize> triangleTable = makeFourierTable<def_tsize>(def_harmonics, TRIANGLE);
 
 FuncTable::FuncTable(unsigned int s, const double *tab, bool norm) {
 	size = s;
 	table = new double[size + 2];
 	normalize = norm;
+	owner = true;
 	if(tab){
 		memcpy(table, tab, size * sizeof(double));
 		//Wrap around points for linear and cubic interpolation.
@@ -88,11 +97,78 @@ void FourierTable::createTable(const unsigned int harmonics, const double *ampAr
 	}
 }
 
-SampleTable::SampleTable(const char* fileName) {
-	int bufferSize = 1024;
-	long framesRead = 0;
-	double *readBuffer = new double[bufferSize];
+namespace {
+
+sf_count_t readFrames(SNDFILE *file, short *buffer, sf_count_t frames) { return sf_readf_short(file, buffer, frames); }
+sf_count_t readFrames(SNDFILE *file, int *buffer, sf_count_t frames) { return sf_readf_int(file, buffer, frames); }
+sf_count_t readFrames(SNDFILE *file, float *buffer, sf_count_t frames) { return sf_readf_float(file, buffer, frames); }
+sf_count_t readFrames(SNDFILE *file, double *buffer, sf_count_t frames) { return sf_readf_double(file, buffer, frames); }
+
+/**
+ * Splits interleaved frames into one contiguous plane per channel. Mono and stereo have their own loops
+ * with fixed strides so the compiler can vectorize them.
+ */
+template<typename T>
+void deinterleave(const T *src, int channels, long count, T **dest) {
+	if(channels == 1) {
+		memcpy(dest[0], src, count * sizeof(T));
+	} else if(channels == 2) {
+		T *left = dest[0], *right = dest[1];
+		for(long i = 0; i < count; i++) {
+			left[i] = src[2*i];
+			right[i] = src[2*i + 1];
+		}
+	} else {
+		for(int c = 0; c < channels; c++) {
+			T *plane = dest[c];
+			for(long i = 0; i < count; i++)
+				plane[i] = src[i * channels + c];
+		}
+	}
+}
 
+}
+
+/**
+ * Reads the whole file as type T and stores it in `data` in the table's storage format, one plane per
+ * channel. 24 bit samples are read as 32 bit integers and packed into their top three bytes.
+ */
+template<typename T>
+void SampleTable::decode(void *file, std::vector<char> &data) {
+	long bufferFrames = std::max(1L, std::min(def_readframes, frames));
+	std::vector<T> readBuffer(bufferFrames * channels);
+	std::vector<T *> dest(channels);
+	long count = 0, framesRead;
+
+	while(count < frames && (framesRead = readFrames((SNDFILE *) file, &readBuffer[0], bufferFrames)) > 0) {
+		framesRead = std::min(framesRead, frames - count);
+		if(format == SAMPLE_INT24) {
+			for(int c = 0; c < channels; c++) {
+				char *plane = &data[(c * (frames + 1) + count) * 3];
+				for(long i = 0; i < framesRead; i++) {
+					unsigned int value = (unsigned int) readBuffer[i * channels + c];
+					plane[3*i] = (char)(value >> 8);
+					plane[3*i + 1] = (char)(value >> 16);
+					plane[3*i + 2] = (char)(value >> 24);
+				}
+			}
+		} else {
+			for(int c = 0; c < channels; c++)
+				dest[c] = (T *) &data[(c * (frames + 1) + count) * sampleBytes];
+			deinterleave(&readBuffer[0], channels, framesRead, &dest[0]);
+		}
+		count += framesRead;
+	}
+}
+
+SampleTable::SampleTable(const char* fileName, SAMPLE_FORMAT storage) : SampleTable() {
+	if(!load(fileName, storage)) {
+		printErrorToConsole();
+		exit(getErrorNumber());
+	}
+}
+
+bool SampleTable::load(const char* fileName, SAMPLE_FORMAT storage) {
 	SF_INFO info;
 	SNDFILE *openFile = sf_open(fileName ,SFM_READ, &info);
 	frames=0; channels =0; samplerate=0;
@@ -100,61 +176,228 @@ SampleTable::SampleTable(const char* fileName) {
 		channels = info.channels;
 		samplerate = info.samplerate;
 		frames = (long) info.frames;
- 		sampTab.resize(frames * channels + 1, 0.0);
-
-		int count = 0;
-		framesRead = sf_readf_double(openFile, readBuffer, bufferSize / channels);
-		while(framesRead != 0) {
-			for(int i = 0; i < framesRead; i++)
-				sampTab[count++] = readBuffer[i];
-			framesRead = sf_readf_double(openFile, readBuffer, bufferSize / channels);
+
+		format = storage;
+		if(format == SAMPLE_NATIVE) {
+			switch(info.format & SF_FORMAT_SUBMASK) {
+			case SF_FORMAT_PCM_S8:
+			case SF_FORMAT_PCM_U8:
+			case SF_FORMAT_PCM_16:
+				format = SAMPLE_INT16;
+				break;
+			case SF_FORMAT_PCM_24:
+				format = SAMPLE_INT24;
+				break;
+			case SF_FORMAT_FLOAT:
+				format = SAMPLE_FLOAT32;
+				break;
+			default:
+				format = SAMPLE_FLOAT64;
+				break;
+			}
+		}
+		sampleBytes = format == SAMPLE_INT16 ? 2 : format == SAMPLE_INT24 ? 3 :
+				format == SAMPLE_FLOAT32 ? 4 : 8;
+
+		// Each channel plane has one extra zeroed sample for the interpolation guard point.
+		std::shared_ptr<std::vector<char> > data =
+				std::make_shared<std::vector<char> >((frames + 1) * channels * sampleBytes, 0);
+		switch(format) {
+		case SAMPLE_INT16:
+			decode<short>(openFile, *data);
+			break;
+		case SAMPLE_INT24:
+			decode<int>(openFile, *data);
+			break;
+		case SAMPLE_FLOAT32:
+			decode<float>(openFile, *data);
+			break;
+		default:
+			decode<double>(openFile, *data);
+			break;
 		}
+		sampTab = data;
 	} else {
-		exception.setError(OPEN_FILE_TO_READ, fileName, DEBUG_INFO);
-		exception.printErrorToConsole();
-		exit(exception.getErrorNumber());
+		sampTab = std::make_shared<const std::vector<char> >();
+		setError(OPEN_FILE_TO_READ, fileName, DEBUG_INFO);
+		return false;
 	}
-	if(openFile)
-		sf_close(openFile);
+	sf_close(openFile);
+	setErrorNumber(NO_ERROR);
+	return true;
 }
 
-SampleReader::SampleReader(const SampleTable &sampTable, double skipTime, bool wrapAround) {
+void SampleTable::convertWindow(long start, long count, int channel, double *dest) const {
+	const char *src = &(*sampTab)[(channel * (frames + 1) + start) * sampleBytes];
+	switch(format) {
+	case SAMPLE_INT16:
+		convertInt16((const short *) src, 1, dest, count);
+		break;
+	case SAMPLE_INT24:
+		convertInt24((const unsigned char *) src, 1, dest, count);
+		break;
+	case SAMPLE_FLOAT32:
+		convertFloat32((const float *) src, 1, dest, count);
+		break;
+	default:
+		memcpy(dest, src, count * sizeof(double));
+		break;
+	}
+}
+
+const double *SampleTable::readWindow(long start, long count, int channel, double *scratch) {
+	if(format == SAMPLE_FLOAT64)
+		return (const double *) &(*sampTab)[(channel * (frames + 1) + start) * sampleBytes];
+	convertWindow(start, count, channel, scratch);
+	return scratch;
+}
+
+std::vector<double> SampleTable::getSampleTable(int channel) const {
+	std::vector<double> samples(frames);
+	if(frames > 0 && channel >= 0 && channel < channels)
+		convertWindow(0, frames, channel, &samples[0]);
+	return samples;
+}
+
+SampleReader::SampleReader(const SampleTable &sampTable, double skipTime, bool wrapAround,
+		INTERPOLATION quality) {
 	this->wrapAround = wrapAround;
 	sampleTable = sampTable;
-	this->skipTime = (int)skipTime * sampleTable.getSampleRate();
-	if(skipTime >= sampleTable.getFrames() || skipTime < 0) {
+	source = NULL;
+	init(sampleTable, skipTime, quality);
+}
+
+SampleReader::SampleReader(SampleSource &src, double skipTime, bool wrapAround, INTERPOLATION quality) {
+	this->wrapAround = wrapAround;
+	source = &src;
+	init(src, skipTime, quality);
+}
+
+void SampleReader::init(SampleSource &src, double skipTime, INTERPOLATION quality) {
+	this->skipTime = (int)skipTime * src.getSampleRate();
+	if(skipTime >= src.getFrames() || skipTime < 0) {
 		exception.setError(SEEK_BEYOND_FILE, "", DEBUG_INFO);
 		exception.printErrorToConsole();
 		exit(exception.getErrorNumber());
 	}
 	frameCount = this->skipTime;
-};
+	rateRatio = getSrate() != 0 && src.getSampleRate() != 0 ? src.getSampleRate() / getSrate() : 1.0;
+	setQuality(quality);
+	channels = src.getChannels() > 0 ? src.getChannels() : 1;
+	channelBuffers.resize(channels - 1);
+	positions.resize(getVectorSize());
+	fractions.resize(getVectorSize());
+	scratch.resize(2 * getVectorSize() + 2 * SincKernel::getReach(INTERP_SINC32, def_maxdecimation) + 8, 0.0);
+	padded.resize(scratch.size(), 0.0);
+	readerId = src.attachReader();
+}
+
+SampleReader::~SampleReader() {
+	if(source)
+		source->detachReader(readerId);
+}
+
+void SampleReader::setQuality(INTERPOLATION quality) {
+	this->quality = quality;
+	kernel = quality == INTERP_LINEAR ? NULL : &SincKernel::get(quality);
+}
+
+/**
+ * Returns frames `lo` to `hi` inclusive of one channel. Frames outside the file read as zero, which gives
+ * the sinc kernel its support at the start and end of the file.
+ */
+const double *SampleReader::fetch(SampleSource &src, long lo, long hi, int channel) {
+	long frames = src.getFrames();
+	if(lo >= 0 && hi <= frames)
+		return src.readWindow(lo, hi - lo + 1, channel, &scratch[0]);
+
+	std::fill(padded.begin(), padded.begin() + (hi - lo + 1), 0.0);
+	long first = std::max(lo, 0L), last = std::min(hi, frames - 1);
+	if(first <= last) {
+		const double *window = src.readWindow(first, last - first + 1, channel, &scratch[0]);
+		std::copy(window, window + (last - first + 1), &padded[first - lo]);
+	}
+	return &padded[0];
+}
 
+/**
+ * Output is produced in runs during which the read position stays inside the file. Each run computes
+ * its read positions once, then for every channel fetches the span of frames it touches with a single
+ * readWindow() call and interpolates from that window. The read position advances by `speed` times the
+ * ratio of the file's sample rate to the engine's, so files at other rates play at their original pitch.
+ */
 const AudioBuffer& SampleReader::process(double speed) {
-	int posi;
-	double frac;
-	for(unsigned int i = 0; i < getVectorSize(); i++) {
-		posi = (int) frameCount;
-		frac = frameCount - posi;
-		if(speed >= 0) {
-			if(frameCount < sampleTable.getFrames()) {
-				vector[i] = sampleTable[posi] + frac * (sampleTable[posi + 1] - sampleTable[posi]);
-				frameCount += speed;
+	SampleSource &src = source != NULL ? *source : sampleTable;
+	long frames = src.getFrames();
+	long capacity = scratch.size();
+	double increment = speed * rateRatio;
+	double step = fabs(increment);
+	int reach = kernel != NULL ? kernel->getReach(step) : 1;
+	long posi, lo, hi;
+	double last;
+	const double *window;
+	double *out;
+	unsigned int i = 0, n, m;
+
+	src.setReadPosition(readerId, frameCount, speed);
+	while(i < getVectorSize()) {
+		if(increment >= 0 ? frameCount >= frames : frameCount <= 0) {
+			if(!wrapAround || frames <= 0) {
+				for(int c = 0; c < channels; c++)
+					channelData(c)[i] = 0;
+				i++;
+				continue;
 			}
-			else if(wrapAround)
-				frameCount = 0;
-			else
-				vector[i] = 0;
-		} else {
-			if(frameCount > 0) {
-				vector[i] = sampleTable[posi] + frac * (sampleTable[posi + 1] - sampleTable[posi]);
-				frameCount += speed;
+			frameCount = increment >= 0 ? 0 : frames - 1;
+			if(increment < 0 && frameCount <= 0) {
+				// A single frame played backwards wraps onto itself without moving.
+				for(int c = 0; c < channels; c++)
+					channelData(c)[i] = *src.readWindow(0, 1, c, &scratch[0]);
+				i++;
+				continue;
+			}
+		}
+
+		// Number of samples before the position leaves the file, limited by the scratch size.
+		n = getVectorSize() - i;
+		if(increment != 0) {
+			double remaining = increment > 0 ? (frames - frameCount) / increment : frameCount / -increment;
+			if(remaining < n)
+				n = (unsigned int) ceil(remaining);
+			if(step * n + 2 * reach + 5 > capacity)
+				n = (unsigned int) ((capacity - 2 * reach - 5) / step);
+			if(n == 0)
+				n = 1;
+		}
+		last = frameCount + increment * (n - 1);
+		lo = (long) std::min(frameCount, last) - reach;
+		hi = (long) std::max(frameCount, last) + reach + 1;
+
+		// Read positions relative to the window, shared by all channels.
+		for(m = 0; m < n; m++) {
+			posi = (long) frameCount;
+			if(posi - reach + 1 < lo || posi + reach > hi ||
+					(increment >= 0 ? frameCount >= frames : frameCount <= 0))
+				break;
+			positions[m] = posi - lo;
+			fractions[m] = frameCount - posi;
+			frameCount += increment;
+		}
+
+		for(int c = 0; c < channels; c++) {
+			window = fetch(src, lo, hi, c);
+			out = channelData(c) + i;
+			if(kernel == NULL) {
+				for(unsigned int k = 0; k < m; k++) {
+					const double *w = window + positions[k];
+					out[k] = w[0] + fractions[k] * (w[1] - w[0]);
+				}
+			} else {
+				for(unsigned int k = 0; k < m; k++)
+					out[k] = kernel->interpolate(window + positions[k], fractions[k], step);
 			}
-			else if(wrapAround)
-				frameCount = sampleTable.getFrames();
-			else
-				vector[i] = 0;
 		}
+		i += m;
 	}
 
 	return *this;
@@ -10,7 +10,14 @@
 
 #include "AudioBase.h"
 #include <vector>
+#include <memory>
 #include "AudioException.h"
+#include "SincKernel.h"
+
+/**
+ * Number of frames requested per read when decoding a sound file.
+ */
+const long def_readframes = 65536;
 
 enum wave_type {
 	SINE = 1,
@@ -19,20 +26,56 @@ enum wave_type {
 	SQUARE
 };
 
+/**
+ * Storage formats for decoded samples in a SampleTable.
+ * SAMPLE_NATIVE - Choose the most compact format that represents the file's encoding losslessly.
+ * SAMPLE_INT16 - 16 bit integer.
+ * SAMPLE_INT24 - 24 bit integer, packed in 3 bytes.
+ * SAMPLE_FLOAT32 - 32 bit float.
+ * SAMPLE_FLOAT64 - 64 bit double.
+ */
+enum SAMPLE_FORMAT {
+	SAMPLE_NATIVE = 0,
+	SAMPLE_INT16,
+	SAMPLE_INT24,
+	SAMPLE_FLOAT32,
+	SAMPLE_FLOAT64
+};
+
+template<unsigned int N> struct ConstTable;
+
 class FuncTable : public AudioParams{
 protected:
 	double *table;
 	unsigned int size;
 	bool normalize;
+	bool owner;
 
 	void normalizeTable();
 
+	/**
+	 * Wraps existing read-only storage of `size + 2` samples without copying it. Used for tables
+	 * whose memory is managed elsewhere.
+	 */
+	FuncTable(const double *tab, unsigned int size) : table(const_cast<double *>(tab)), size(size),
+		normalize(false), owner(false) {}
+
 public:
 	FuncTable(unsigned int size = def_tsize, const double *tab = NULL, bool norm = false);
 
-	~FuncTable(){ delete[] table; }
+	/**
+	 * Wraps a compile time generated table (see ConstTables.h) without copying it. The
+	 * samples are read-only and must outlive this object.
+	 */
+	template<unsigned int N>
+	FuncTable(const ConstTable<N> &tab) : FuncTable(tab.getTable(), N) {}
 
-	double *getTable() const { return table; }
+	virtual ~FuncTable(){
+		if(owner)
+			delete[] table;
+	}
+
+	const double *getTable() const { return table; }
 
 	unsigned int getSize() const{ return size; }
 };
@@ -59,36 +102,189 @@ public:
 
 };
 
-class SampleTable : public AudioException{
+/**
+ * Interface for sample data read by SampleReader. A reader requests a window of consecutive frames once
+ * per run of output samples instead of indexing the data per sample, so sources that do not keep the whole
+ * file in memory can copy or convert only the span that is needed.
+ */
+class SampleSource {
+public:
+	virtual ~SampleSource() {}
+
+	virtual int getChannels() = 0;
+	virtual double getSampleRate() = 0;
+	virtual long getFrames() = 0;
+
+	/**
+	 * Returns `count` consecutive frames of one channel starting at `start`. Frames at or beyond
+	 * `getFrames()` read as zero. The returned pointer is either into the source's own storage or
+	 * `scratch`, which must hold at least `count` values. It stays valid until the next call with the same
+	 * scratch buffer.
+	 */
+	virtual const double *readWindow(long start, long count, int channel, double *scratch) = 0;
+
+	/**
+	 * Registers a reader. Sources that prefetch use the returned id to track its play position.
+	 */
+	virtual int attachReader() { return 0; }
+
+	virtual void detachReader(int /*id*/) {}
+
+	/**
+	 * Reports the play position in frames and the playback speed of an attached reader.
+	 */
+	virtual void setReadPosition(int /*id*/, double /*position*/, double /*speed*/) {}
+};
+
+/**
+ * Sound file decoded into memory. Channels are deinterleaved on load into one plane per channel. Samples
+ * are kept in a compact storage format (by default the file's own sample format) and converted to double
+ * only for the frames a reader requests. The decoded samples are
+ * immutable and reference counted, so copying a SampleTable (for instance into a SampleReader) shares
+ * the data instead of duplicating it.
+ */
+class SampleTable : public AudioException, public SampleSource {
 protected:
-	std::vector<double> sampTab;
+	std::shared_ptr<const std::vector<char> > sampTab;
+	SAMPLE_FORMAT format;
+	int sampleBytes;
 	int channels;
 	double samplerate;
 	long frames;
 	AudioException exception;
 
+	template<typename T>
+	void decode(void *file, std::vector<char> &data);
+
+	void convertWindow(long start, long count, int channel, double *dest) const;
+
 public:
-	SampleTable() : channels(0), samplerate(0), frames(0) {}
-	SampleTable(const char* fileName);
+	SampleTable() : sampTab(std::make_shared<const std::vector<char> >()), format(SAMPLE_FLOAT64),
+		sampleBytes(sizeof(double)), channels(0), samplerate(0), frames(0) {}
+
+	/**
+	 * Decodes a sound file.
+	 * @param fileName File to decode.
+	 * @param storage Storage format for the decoded samples. SAMPLE_NATIVE keeps 8 and 16 bit files as
+	 * SAMPLE_INT16, 24 bit files as SAMPLE_INT24, float files as SAMPLE_FLOAT32 and everything else as
+	 * SAMPLE_FLOAT64.
+	 */
+	SampleTable(const char* fileName, SAMPLE_FORMAT storage = SAMPLE_NATIVE);
+
+	/**
+	 * Decodes a sound file into this table, replacing its contents. Unlike the constructor, a file that
+	 * cannot be opened does not end the program: the table is left empty, the error is set and false is
+	 * returned.
+	 */
+	bool load(const char* fileName, SAMPLE_FORMAT storage = SAMPLE_NATIVE);
 
 	int getChannels() { return channels; }
 	double getSampleRate() { return samplerate; }
 	long getFrames() { return frames; }
-	std::vector<double> getSampleTable() { return sampTab; }
+	SAMPLE_FORMAT getFormat() const { return format; }
+
+	/**
+	 * Returns a copy of one channel's samples converted to double.
+	 */
+	std::vector<double> getSampleTable(int channel = 0) const;
+
+	/**
+	 * Size in bytes of the decoded samples, which are shared by every copy of this table.
+	 */
+	size_t getMemoryUsage() const { return sampTab->capacity(); }
 
-	const double operator[](int index) { return sampTab[index];	}
+	/**
+	 * Number of SampleTable copies currently sharing the decoded samples.
+	 */
+	long getReferenceCount() const { return sampTab.use_count(); }
+
+	const double *readWindow(long start, long count, int channel, double *scratch);
+
+	const double operator[](int index) {
+		double value;
+		return *readWindow(index, 1, 0, &value);
+	}
 };
 
+/**
+ * Plays a SampleSource. The first channel is output through the reader itself; every channel is available
+ * through getChannel(). All channels are produced in the same pass from one set of read positions.
+ */
 class SampleReader : public AudioBuffer {
 protected:
 	double frameCount;
 	double skipTime;
 	bool wrapAround;
+	double rateRatio;
+	INTERPOLATION quality;
+	const SincKernel *kernel;
 	SampleTable sampleTable;
+	SampleSource *source;
+	int readerId;
+	int channels;
+	std::vector<AudioBuffer> channelBuffers;
+	std::vector<long> positions;
+	std::vector<double> fractions;
+	std::vector<double> scratch;
+	std::vector<double> padded;
+
+	void init(SampleSource &src, double skipTime, INTERPOLATION quality);
+	const double *fetch(SampleSource &src, long lo, long hi, int channel);
+	double *channelData(int channel) { return channel == 0 ? &vector[0] : writableData(channelBuffers[channel - 1]); }
+
 public:
 
-	SampleReader(const SampleTable &sampTable, double skipTime = 0.0, bool wrapAround = false);
+	/**
+	 * @param sampTable Table to play. Its samples are shared, not copied.
+	 * @param skipTime Start position in seconds.
+	 * @param wrapAround Loop playback at the ends of the table.
+	 * @param quality Interpolation tier. INTERP_LINEAR is cheapest; the sinc tiers use polyphase
+	 * windowed-sinc kernels that also band-limit the signal when playing faster than the file's rate.
+	 */
+	SampleReader(const SampleTable &sampTable, double skipTime = 0.0, bool wrapAround = false,
+			INTERPOLATION quality = INTERP_LINEAR);
+
+	/**
+	 * Reads from an external source such as a SampleStream, without copying its data. The source must
+	 * outlive the reader.
+	 */
+	SampleReader(SampleSource &source, double skipTime = 0.0, bool wrapAround = false,
+			INTERPOLATION quality = INTERP_LINEAR);
+
+	virtual ~SampleReader();
+
+	/**
+	 * A reader owns its registration with the source, so it cannot be copied.
+	 */
+	SampleReader(const SampleReader &) = delete;
+	SampleReader &operator=(const SampleReader &) = delete;
+
+	/**
+	 * Change the interpolation tier. Takes effect on the next process() call. The first reader to use a
+	 * sinc tier builds its shared kernel, which allocates, so select a new tier outside the audio callback.
+	 */
+	void setQuality(INTERPOLATION quality);
+
+	INTERPOLATION getQuality() const { return quality; }
+
+	/**
+	 * Number of channels produced, which is the number of channels of the source.
+	 */
+	int getChannels() const { return channels; }
+
+	/**
+	 * Output of one channel for the last process() call. Channel 0 is the reader itself.
+	 */
+	const AudioBuffer &getChannel(int channel) const {
+		if(channel == 0)
+			return *this;
+		return channelBuffers[channel - 1];
+	}
 
+	/**
+	 * Plays the source for one vector. A `playbackSpeed` of 1 plays at the original pitch, whatever the
+	 * file's sample rate; negative speeds play backwards. Returns the first channel.
+	 */
 	const AudioBuffer &process(double playbackSpeed = 1.0);
 
 };
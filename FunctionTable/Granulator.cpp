@@ -0,0 +1,192 @@
+/*
+ * Granulator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "Granulator.h"
+#include <cmath>
+#include <algorithm>
+
+GrainWindow::GrainWindow(GRAIN_WINDOW type) : table(def_grainwindow + 2, 0.0) {
+	for(unsigned int i = 0; i < def_grainwindow; i++) {
+		double x = (double) i / def_grainwindow;
+		switch(type) {
+		case WINDOW_GAUSSIAN :
+			table[i] = exp(-0.5 * pow((x - 0.5) / 0.15, 2.0));
+			break;
+		case WINDOW_TRIANGLE :
+			table[i] = 1.0 - fabs(2.0 * x - 1.0);
+			break;
+		case WINDOW_TUKEY :
+			// Cosine tapers over the first and last quarter, flat in between.
+			if(x < 0.25)
+				table[i] = 0.5 - 0.5 * cos(TWOPI * x * 2.0);
+			else if(x > 0.75)
+				table[i] = 0.5 - 0.5 * cos(TWOPI * (1.0 - x) * 2.0);
+			else
+				table[i] = 1.0;
+			break;
+		default :
+			table[i] = 0.5 - 0.5 * cos(TWOPI * x);
+			break;
+		}
+	}
+}
+
+const GrainWindow &GrainWindow::get(GRAIN_WINDOW type) {
+	static const GrainWindow hann(WINDOW_HANN);
+	static const GrainWindow gaussian(WINDOW_GAUSSIAN);
+	static const GrainWindow triangle(WINDOW_TRIANGLE);
+	static const GrainWindow tukey(WINDOW_TUKEY);
+	switch(type) {
+	case WINDOW_GAUSSIAN:
+		return gaussian;
+	case WINDOW_TRIANGLE:
+		return triangle;
+	case WINDOW_TUKEY:
+		return tukey;
+	default:
+		return hann;
+	}
+}
+
+Granulator::Granulator(const SampleTable &sampTable, int channel, GRAIN_WINDOW window, unsigned int maxGrains) :
+		sampleTable(sampTable), channel(channel), scratch(4 * vectorSize + 2), frames(0), rateRatio(1.0), window(GrainWindow::get(window).getTable()),
+		maxGrains(maxGrains), activeGrains(0), positions(maxGrains), speeds(maxGrains), phases(maxGrains),
+		phaseIncs(maxGrains), gains(maxGrains), remaining(maxGrains), offsets(maxGrains),
+		density(20.0), duration(0.05), position(0.0), speed(1.0), jitter(0.0), amplitude(0.5),
+		untilNext(0.0), seed(1), dropped(0) {
+
+	// A channel the table does not have plays silence.
+	if(channel >= 0 && channel < sampleTable.getChannels())
+		frames = sampleTable.getFrames();
+	rateRatio = sampleTable.getSampleRate() / srate;
+}
+
+/**
+ * Uniform random number in [-1, 1].
+ */
+double Granulator::random() {
+	seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+	return seed / (double) 0x3fffffffUL - 1.0;
+}
+
+/**
+ * Starts a grain `offset` samples into the next rendered block. The start is moved, or the grain
+ * shortened, so that every frame it reads lies inside the table.
+ */
+void Granulator::spawn(int offset, double start, double length, double rate, double gain) {
+	if(activeGrains == maxGrains) {
+		dropped++;
+		return;
+	}
+	if(frames < 2)
+		return;
+
+	long samples = std::max(1L, (long)(length * srate));
+	double step = rate * rateRatio;
+	double first = start * srate * rateRatio;
+	double last = frames - 1;
+	double span = (samples - 1) * fabs(step);
+	if(span > last) {
+		samples = (long)(last / fabs(step)) + 1;
+		span = (samples - 1) * fabs(step);
+	}
+	if(step >= 0)
+		first = std::min(std::max(first, 0.0), last - span);
+	else
+		first = std::min(std::max(first, span), last);
+
+	unsigned int g = activeGrains++;
+	positions[g] = first;
+	speeds[g] = step;
+	phases[g] = 0.0;
+	phaseIncs[g] = (double) def_grainwindow / samples;
+	gains[g] = gain;
+	remaining[g] = samples;
+	offsets[g] = offset;
+}
+
+void Granulator::trigger(double start, double length, double rate, double gain) {
+	spawn(0, start, length, rate, gain);
+}
+
+/**
+ * Sums every active grain into the output. A grain reads the frames it covers in this block through
+ * readWindow(), in runs short enough for the scratch buffer. Each sample of a grain is computed from the
+ * run's start values rather than from the previous sample, so the inner loop has no dependency between
+ * iterations and can be vectorized.
+ */
+void Granulator::render() {
+	double *out = &vector[0];
+	const double *win = window;
+	std::fill(vector.begin(), vector.end(), 0.0);
+	// A run of m samples reads at most (m - 1) * |step| + 3 frames: its span, one more where the span
+	// straddles frame boundaries, and the interpolation point after the last. The table's guard point
+	// makes that point readable at the last frame.
+	const double capacity = (double)(scratch.size() - 3);
+
+	unsigned int g = 0;
+	while(g < activeGrains) {
+		int offset = offsets[g];
+		long n = std::min(remaining[g], (long) vectorSize - offset);
+		double pos = positions[g], step = speeds[g];
+		double phase = phases[g], inc = phaseIncs[g];
+		double gain = gains[g];
+		long runLength = step != 0.0 ? std::max(1L, (long)(capacity / fabs(step)) + 1) : n;
+
+		for(long done = 0, m; done < n; done += m) {
+			m = std::min(n - done, runLength);
+			double start = pos + done * step;
+			double end = start + (m - 1) * step;
+			long first = (long) std::min(start, end);
+			long count = (long) std::max(start, end) - first + 2;
+			const double *src = sampleTable.readWindow(first, count, channel, &scratch[0]);
+			double from = start - first;
+			double w0 = phase + done * inc;
+			double *dest = out + offset + done;
+
+			for(long i = 0; i < m; i++) {
+				double p = from + i * step;
+				long ip = (long) p;
+				double s = src[ip] + (p - ip) * (src[ip + 1] - src[ip]);
+				double w = w0 + i * inc;
+				long iw = (long) w;
+				double e = win[iw] + (w - iw) * (win[iw + 1] - win[iw]);
+				dest[i] += gain * e * s;
+			}
+		}
+
+		remaining[g] -= n;
+		if(remaining[g] > 0) {
+			positions[g] = pos + n * step;
+			phases[g] = phase + n * inc;
+			offsets[g] = 0;
+			g++;
+			continue;
+		}
+		unsigned int last = --activeGrains;
+		positions[g] = positions[last];
+		speeds[g] = speeds[last];
+		phases[g] = phases[last];
+		phaseIncs[g] = phaseIncs[last];
+		gains[g] = gains[last];
+		remaining[g] = remaining[last];
+		offsets[g] = offsets[last];
+	}
+}
+
+const Granulator &Granulator::process() {
+	if(density > 0.0) {
+		double interval = srate / density;
+		while(untilNext < vectorSize) {
+			spawn((int) untilNext, position + jitter * random(), duration, speed, amplitude);
+			untilNext += interval;
+		}
+		untilNext -= vectorSize;
+	}
+	render();
+	return *this;
+}
@@ -0,0 +1,173 @@
+/*
+ * Granulator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef GRANULATOR_H_
+#define GRANULATOR_H_
+
+#include "AudioBase.h"
+#include "FunctionTable.h"
+#include <vector>
+
+/**
+ * Grain envelope shapes.
+ */
+enum GRAIN_WINDOW {
+	WINDOW_HANN = 0,
+	WINDOW_GAUSSIAN,
+	WINDOW_TRIANGLE,
+	WINDOW_TUKEY
+};
+
+/**
+ * Number of points in a grain window table.
+ */
+const unsigned int def_grainwindow = 2048;
+/**
+ * Default size of the grain pool.
+ */
+const unsigned int def_maxgrains = 4096;
+
+/**
+ * Grain envelope table covering one grain over phase 0 to 1. Two zero guard points follow the last
+ * point so a phase of exactly 1 interpolates to silence. Windows are shared: use get() to obtain one.
+ */
+class GrainWindow {
+protected:
+	std::vector<double> table;
+
+	GrainWindow(GRAIN_WINDOW type);
+
+public:
+	static const GrainWindow &get(GRAIN_WINDOW type);
+
+	const double *getTable() const { return &table[0]; }
+};
+
+/**
+ * Granular synthesis on a SampleTable. Grains are short windowed readings of one channel of the table;
+ * new grains are started at a steady rate and sum into the output.
+ *
+ * All grains live in a pool allocated at construction, stored as one array per grain parameter. Active
+ * grains are kept at the front of the pool, and a finished grain is replaced by the last active one, so
+ * rendering walks contiguous arrays and never allocates. When the pool is full new grains are dropped
+ * and counted (see getDroppedGrains()).
+ *
+ * The table's samples are shared with every other copy of it, in their compact storage format. Each block,
+ * a grain converts only the frames it reads, through SampleTable::readWindow() into a scratch buffer;
+ * tables stored as doubles are read in place.
+ */
+class Granulator : public AudioBuffer {
+protected:
+	SampleTable sampleTable;
+	int channel;
+	std::vector<double> scratch;
+	long frames;
+	double rateRatio;
+	const double *window;
+
+	unsigned int maxGrains;
+	unsigned int activeGrains;
+	std::vector<double> positions;
+	std::vector<double> speeds;
+	std::vector<double> phases;
+	std::vector<double> phaseIncs;
+	std::vector<double> gains;
+	std::vector<long> remaining;
+	std::vector<int> offsets;
+
+	double density;
+	double duration;
+	double position;
+	double speed;
+	double jitter;
+	double amplitude;
+	double untilNext;
+	unsigned long seed;
+	unsigned long dropped;
+
+	double random();
+	void spawn(int offset, double start, double length, double rate, double gain);
+	void render();
+
+public:
+	/**
+	 * @param sampTable Table to granulate. Its samples are shared, not copied.
+	 * @param channel Channel of the table that grains read from.
+	 * @param window Grain envelope.
+	 * @param maxGrains Size of the grain pool, i.e. the largest number of simultaneous grains.
+	 */
+	Granulator(const SampleTable &sampTable, int channel = 0, GRAIN_WINDOW window = WINDOW_HANN,
+			unsigned int maxGrains = def_maxgrains);
+
+	virtual ~Granulator() {}
+
+	/**
+	 * Number of grains started per second.
+	 */
+	void setDensity(double grainsPerSecond) { density = grainsPerSecond; }
+
+	/**
+	 * Length of each grain in seconds.
+	 */
+	void setDuration(double seconds) { duration = seconds; }
+
+	/**
+	 * Position in the table, in seconds, at which new grains start.
+	 */
+	void setPosition(double seconds) { position = seconds; }
+
+	/**
+	 * Playback speed of new grains. 1 plays at the original pitch, negative values play backwards.
+	 */
+	void setSpeed(double ratio) { speed = ratio; }
+
+	/**
+	 * Largest random offset in seconds added to the start position of each grain.
+	 */
+	void setPositionJitter(double seconds) { jitter = seconds; }
+
+	/**
+	 * Peak gain of new grains.
+	 */
+	void setAmplitude(double amp) { amplitude = amp; }
+
+	void setWindow(GRAIN_WINDOW type) { window = GrainWindow::get(type).getTable(); }
+
+	/**
+	 * Starts a single grain at the beginning of the next block, independently of the density setting.
+	 * @param start Position in the table in seconds.
+	 * @param length Grain length in seconds.
+	 * @param rate Playback speed.
+	 * @param gain Peak gain.
+	 */
+	void trigger(double start, double length, double rate = 1.0, double gain = 1.0);
+
+	unsigned int getActiveGrains() const { return activeGrains; }
+
+	unsigned int getMaxGrains() const { return maxGrains; }
+
+	/**
+	 * Number of grains that could not start because the pool was full.
+	 */
+	unsigned long getDroppedGrains() const { return dropped; }
+
+	/**
+	 * Starts the grains due in this block and renders all active grains.
+	 */
+	const Granulator &process();
+
+	const Granulator &process(double seconds) {
+		position = seconds;
+		return process();
+	}
+
+	const Granulator &operator()() { return process(); }
+
+	const Granulator &operator()(double seconds) { return process(seconds); }
+};
+
+#endif /* GRANULATOR_H_ */
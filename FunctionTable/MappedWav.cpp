@@ -0,0 +1,190 @@
+/*
+ * MappedWav.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "MappedWav.h"
+#include "SampleConvert.h"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const uint16_t WAVE_FORMAT_PCM = 0x0001;
+const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+// WAV is little endian. Fields are read byte by byte since chunks need not be aligned.
+uint16_t readU16(const unsigned char *p) { return p[0] | p[1] << 8; }
+uint32_t readU32(const unsigned char *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t) p[3] << 24; }
+
+/**
+ * Converts samples of type T that may not be aligned for T, as the data chunk can start at any even
+ * offset. Each sample is copied into a local before use; compilers turn the copy into a plain load.
+ */
+template<typename T>
+void convertUnaligned(const unsigned char *src, long stride, double *dest, long count, double scale) {
+	for(long i = 0; i < count; i++) {
+		T value;
+		memcpy(&value, src + i * stride * sizeof(T), sizeof(T));
+		dest[i] = value * scale;
+	}
+}
+
+void *mapFile(const char *fileName, size_t &size) {
+	int fd = open(fileName, O_RDONLY);
+	if(fd < 0)
+		return NULL;
+	struct stat st;
+	void *map = NULL;
+	if(fstat(fd, &st) == 0 && st.st_size > 0) {
+		size = st.st_size;
+		map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+		if(map == MAP_FAILED)
+			map = NULL;
+	}
+	close(fd);
+	return map;
+}
+
+}
+
+MappedWav::MappedWav(const char *fileName) : MappedWav() {
+
+	mapping = mapFile(fileName, mappingSize);
+	if(mapping == NULL) {
+		exception.setError(OPEN_FILE_TO_READ, fileName, DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+	std::string error;
+	if(!parse(error)) {
+		exception.setError(UNSUPPORTED_FORMAT, std::string(fileName) + ": " + error, DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+	madvise(mapping, mappingSize, MADV_WILLNEED);
+}
+
+MappedWav::~MappedWav() {
+	if(mapping != NULL)
+		munmap(mapping, mappingSize);
+}
+
+bool MappedWav::isSupported(const char *fileName) {
+	size_t size = 0;
+	void *map = mapFile(fileName, size);
+	if(map == NULL)
+		return false;
+
+	MappedWav probe;
+	probe.mapping = map;
+	probe.mappingSize = size;
+	std::string error;
+	return probe.parse(error);
+}
+
+/**
+ * Walks the RIFF chunks for `fmt ` and `data`, validating the encoding.
+ */
+bool MappedWav::parse(std::string &error) {
+	const unsigned char *file = (const unsigned char *) mapping;
+	if(mappingSize < 12 || memcmp(file, "RIFF", 4) != 0 || memcmp(file + 8, "WAVE", 4) != 0) {
+		error = "Not a RIFF WAVE file";
+		return false;
+	}
+
+	bool haveFormat = false;
+	uint16_t formatTag = 0, blockAlign = 0;
+	size_t offset = 12;
+	while(offset + 8 <= mappingSize) {
+		const unsigned char *chunk = file + offset;
+		size_t chunkSize = readU32(chunk + 4);
+		const unsigned char *body = chunk + 8;
+		size_t available = mappingSize - offset - 8;
+
+		if(memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && chunkSize <= available) {
+			formatTag = readU16(body);
+			channels = readU16(body + 2);
+			samplerate = readU32(body + 4);
+			blockAlign = readU16(body + 12);
+			bitsPerSample = readU16(body + 14);
+			if(formatTag == WAVE_FORMAT_EXTENSIBLE && chunkSize >= 40)
+				formatTag = readU16(body + 24);
+			haveFormat = true;
+		} else if(memcmp(chunk, "data", 4) == 0) {
+			if(!haveFormat) {
+				error = "data chunk before fmt chunk";
+				return false;
+			}
+			// Truncated files are played up to the end of the mapping.
+			if(chunkSize > available)
+				chunkSize = available;
+			data = body;
+			frames = blockAlign > 0 ? chunkSize / blockAlign : 0;
+			break;
+		}
+		offset += 8 + chunkSize + (chunkSize & 1);
+	}
+
+	if(data == NULL) {
+		error = "No data chunk";
+		return false;
+	}
+	isFloat = formatTag == WAVE_FORMAT_IEEE_FLOAT;
+	if(formatTag != WAVE_FORMAT_PCM && !isFloat) {
+		error = "Compressed WAV encoding";
+		return false;
+	}
+	if(isFloat ? (bitsPerSample != 32 && bitsPerSample != 64) :
+			(bitsPerSample != 8 && bitsPerSample != 16 && bitsPerSample != 24 && bitsPerSample != 32)) {
+		error = "Unsupported bit depth";
+		return false;
+	}
+	if(channels <= 0 || blockAlign != channels * bitsPerSample / 8) {
+		error = "Inconsistent channel layout";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Deinterleaves and converts one channel directly from the mapped data.
+ */
+const double *MappedWav::readWindow(long start, long count, int channel, double *scratch) {
+	long valid = std::max(0L, std::min(count, frames - start));
+	int bytes = bitsPerSample / 8;
+	const unsigned char *src = data + ((size_t) start * channels + channel) * bytes;
+
+	switch(bitsPerSample) {
+	case 8:
+		convertUint8(src, channels, scratch, valid);
+		break;
+	case 16:
+		convertUnaligned<int16_t>(src, channels, scratch, valid, 1.0 / 32768.0);
+		break;
+	case 24:
+		convertInt24(src, channels, scratch, valid);
+		break;
+	case 32:
+		if(isFloat)
+			convertUnaligned<float>(src, channels, scratch, valid, 1.0);
+		else
+			convertUnaligned<int32_t>(src, channels, scratch, valid, 1.0 / 2147483648.0);
+		break;
+	case 64:
+		convertUnaligned<double>(src, channels, scratch, valid, 1.0);
+		break;
+	}
+	for(long i = valid; i < count; i++)
+		scratch[i] = 0.0;
+	return scratch;
+}
@@ -0,0 +1,60 @@
+/*
+ * MappedWav.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef MAPPEDWAV_H_
+#define MAPPEDWAV_H_
+
+#include "FunctionTable.h"
+#include "AudioException.h"
+#include <string>
+
+/**
+ * Zero-copy sample source for uncompressed WAV files. The file is memory-mapped read-only and its RIFF
+ * header parsed directly; SampleReader reads and converts frames straight from the mapped data chunk.
+ * Nothing is decoded up front, the page cache holds the audio, and processes mapping the same file share
+ * its physical pages.
+ *
+ * Supported encodings: 8, 16, 24 and 32 bit integer PCM and 32 and 64 bit float, including
+ * WAVE_FORMAT_EXTENSIBLE headers. Use isSupported() to check a file before opening it; other files can be
+ * loaded with SampleTable.
+ */
+class MappedWav : public AudioException, public SampleSource {
+protected:
+	void *mapping;
+	size_t mappingSize;
+	const unsigned char *data;
+	int channels;
+	double samplerate;
+	long frames;
+	int bitsPerSample;
+	bool isFloat;
+	AudioException exception;
+
+	MappedWav() : mapping(NULL), mappingSize(0), data(NULL), channels(0), samplerate(0), frames(0),
+		bitsPerSample(0), isFloat(false) {}
+
+	bool parse(std::string &error);
+
+public:
+	MappedWav(const char *fileName);
+
+	~MappedWav();
+
+	/**
+	 * True if `fileName` is a WAV file whose encoding MappedWav can read.
+	 */
+	static bool isSupported(const char *fileName);
+
+	int getChannels() { return channels; }
+	double getSampleRate() { return samplerate; }
+	long getFrames() { return frames; }
+	int getBitsPerSample() const { return bitsPerSample; }
+
+	const double *readWindow(long start, long count, int channel, double *scratch);
+};
+
+#endif /* MAPPEDWAV_H_ */
@@ -0,0 +1,43 @@
+/*
+ * SampleConvert.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef SAMPLECONVERT_H_
+#define SAMPLECONVERT_H_
+
+/**
+ * Kernels converting stored samples to double. `stride` is the distance in samples between consecutive
+ * frames of the channel being read: 1 for planar storage, the channel count for interleaved storage.
+ * They are plain loops so that, once inlined with a constant stride, the compiler can vectorize them.
+ */
+
+inline void convertUint8(const unsigned char *src, long stride, double *dest, long count) {
+	const double scale = 1.0 / 128.0;
+	for(long i = 0; i < count; i++)
+		dest[i] = ((int) src[i * stride] - 128) * scale;
+}
+
+inline void convertInt16(const short *src, long stride, double *dest, long count) {
+	const double scale = 1.0 / 32768.0;
+	for(long i = 0; i < count; i++)
+		dest[i] = src[i * stride] * scale;
+}
+
+inline void convertInt24(const unsigned char *src, long stride, double *dest, long count) {
+	const double scale = 1.0 / 8388608.0;
+	for(long i = 0; i < count; i++) {
+		const unsigned char *s = src + 3 * i * stride;
+		int value = (int)((unsigned int)s[0] << 8 | (unsigned int)s[1] << 16 | (unsigned int)s[2] << 24) >> 8;
+		dest[i] = value * scale;
+	}
+}
+
+inline void convertFloat32(const float *src, long stride, double *dest, long count) {
+	for(long i = 0; i < count; i++)
+		dest[i] = src[i * stride];
+}
+
+#endif /* SAMPLECONVERT_H_ */
@@ -0,0 +1,85 @@
+/*
+ * SampleLoader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "SampleLoader.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+SampleLoader::SampleLoader(unsigned int threads) : totalTime(0.0) {
+	if(threads == 0)
+		threads = std::thread::hardware_concurrency();
+	this->threads = threads > 0 ? threads : 1;
+}
+
+std::vector<SampleTable> SampleLoader::load(const std::vector<std::string> &files, SAMPLE_FORMAT storage,
+		Progress progress) {
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start = Clock::now();
+
+	std::vector<SampleTable> tables(files.size());
+	fileNames = files;
+	fileTimes.assign(files.size(), 0.0);
+	fileErrors.assign(files.size(), NO_ERROR);
+
+	std::atomic<unsigned int> next(0);
+	unsigned int done = 0;
+	std::mutex progressMutex;
+
+	// Workers claim the next file index until every file is taken. Each result goes to its own slot.
+	// Failures are recorded rather than reported through the table, which would end the program from a
+	// worker thread.
+	std::function<void()> worker = [&]() {
+		unsigned int index;
+		while((index = next++) < files.size()) {
+			Clock::time_point fileStart = Clock::now();
+			if(!tables[index].load(files[index].c_str(), storage))
+				fileErrors[index] = tables[index].getErrorNumber();
+			fileTimes[index] = std::chrono::duration<double>(Clock::now() - fileStart).count();
+
+			std::lock_guard<std::mutex> lock(progressMutex);
+			done++;
+			if(progress)
+				progress(done, files.size(), index);
+		}
+	};
+
+	unsigned int count = std::min<unsigned int>(threads, files.size());
+	std::vector<std::thread> pool;
+	for(unsigned int i = 1; i < count; i++)
+		pool.push_back(std::thread(worker));
+	worker();
+	for(unsigned int i = 0; i < pool.size(); i++)
+		pool[i].join();
+
+	totalTime = std::chrono::duration<double>(Clock::now() - start).count();
+	return tables;
+}
+
+unsigned int SampleLoader::getFailedCount() const {
+	unsigned int failed = 0;
+	for(unsigned int i = 0; i < fileErrors.size(); i++)
+		if(fileErrors[i] != NO_ERROR)
+			failed++;
+	return failed;
+}
+
+void SampleLoader::printTimings() const {
+	double sum = 0.0;
+	for(unsigned int i = 0; i < fileNames.size(); i++) {
+		std::cout << fileNames[i] << ": " << fileTimes[i] << " sec";
+		if(fileErrors[i] != NO_ERROR)
+			std::cout << " (could not be opened)";
+		std::cout << std::endl;
+		sum += fileTimes[i];
+	}
+	std::cout << "Files: " << fileNames.size() << ", failed: " << getFailedCount() << ", threads: " << threads
+			<< std::endl;
+	std::cout << "Decoding time (sec): " << sum << ", wall clock time (sec): " << totalTime << std::endl;
+}
@@ -0,0 +1,81 @@
+/*
+ * SampleLoader.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef SAMPLELOADER_H_
+#define SAMPLELOADER_H_
+
+#include "FunctionTable.h"
+#include <vector>
+#include <string>
+#include <functional>
+
+/**
+ * Decodes a list of sound files concurrently on a pool of worker threads. Used to load multisample
+ * instruments, where decoding hundreds of files one after the other dominates start up time.
+ */
+class SampleLoader {
+public:
+	/**
+	 * Called from a worker thread each time a file has been decoded, with the number of files done so far,
+	 * the total, and the index of the file that finished. Calls are serialized. Files that could not be
+	 * opened are reported too; check getFileError() for the index.
+	 */
+	typedef std::function<void(unsigned int done, unsigned int total, unsigned int index)> Progress;
+
+protected:
+	unsigned int threads;
+	std::vector<std::string> fileNames;
+	std::vector<double> fileTimes;
+	std::vector<ERROR_TYPE> fileErrors;
+	double totalTime;
+
+public:
+	/**
+	 * @param threads Number of worker threads. 0 uses the number of hardware threads.
+	 */
+	SampleLoader(unsigned int threads = 0);
+
+	/**
+	 * Decodes every file and returns the tables in the same order as `files`. Blocks until all files are
+	 * decoded. A file that cannot be opened does not stop the others; its table is left empty and the
+	 * error is recorded for getFileError().
+	 * @param files Sound files to decode.
+	 * @param storage Storage format passed to each SampleTable.
+	 * @param progress Optional progress callback.
+	 */
+	std::vector<SampleTable> load(const std::vector<std::string> &files,
+			SAMPLE_FORMAT storage = SAMPLE_NATIVE, Progress progress = Progress());
+
+	unsigned int getThreads() const { return threads; }
+
+	/**
+	 * Decoding time in seconds of file `index` of the last load() call.
+	 */
+	double getFileTime(unsigned int index) const { return fileTimes[index]; }
+
+	/**
+	 * Error of file `index` of the last load() call, NO_ERROR if it was decoded.
+	 */
+	ERROR_TYPE getFileError(unsigned int index) const { return fileErrors[index]; }
+
+	/**
+	 * Number of files of the last load() call that could not be decoded.
+	 */
+	unsigned int getFailedCount() const;
+
+	/**
+	 * Wall clock time in seconds of the last load() call.
+	 */
+	double getTotalTime() const { return totalTime; }
+
+	/**
+	 * Print per file decoding times of the last load() call to the console.
+	 */
+	void printTimings() const;
+};
+
+#endif /* SAMPLELOADER_H_ */
@@ -0,0 +1,123 @@
+/*
+ * SamplePool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "SamplePool.h"
+#include <iostream>
+
+/**
+ * The first request for a file registers it as pending and decodes it without holding the lock, so
+ * other threads are not held up by an unrelated decode. Later requests for the same file wait for the
+ * pending decode.
+ */
+SampleTable SamplePool::get(const char *fileName) {
+	std::unique_lock<std::mutex> lock(mutex);
+	std::map<std::string, SampleTable>::iterator it = tables.find(fileName);
+	if(it != tables.end())
+		return it->second;
+	std::map<std::string, std::shared_future<SampleTable> >::iterator waiting = pending.find(fileName);
+	if(waiting != pending.end()) {
+		std::shared_future<SampleTable> decoded = waiting->second;
+		lock.unlock();
+		return decoded.get();
+	}
+
+	std::promise<SampleTable> promise;
+	pending[fileName] = promise.get_future().share();
+	lock.unlock();
+
+	SampleTable table;
+	bool loaded = table.load(fileName);
+
+	lock.lock();
+	if(loaded)
+		tables.insert(std::make_pair(std::string(fileName), table));
+	pending.erase(fileName);
+	lock.unlock();
+
+	promise.set_value(table);
+	return table;
+}
+
+unsigned int SamplePool::preload(const std::vector<std::string> &files, SampleLoader &loader,
+		SampleLoader::Progress progress) {
+	std::vector<std::string> missing;
+	std::vector<std::promise<SampleTable> > promises;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for(unsigned int i = 0; i < files.size(); i++) {
+			if(tables.find(files[i]) == tables.end() && pending.find(files[i]) == pending.end()) {
+				missing.push_back(files[i]);
+				promises.push_back(std::promise<SampleTable>());
+				pending[files[i]] = promises.back().get_future().share();
+			}
+		}
+	}
+
+	std::vector<SampleTable> loaded = loader.load(missing, SAMPLE_NATIVE, progress);
+
+	unsigned int decoded = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for(unsigned int i = 0; i < missing.size(); i++) {
+			if(loader.getFileError(i) == NO_ERROR) {
+				tables.insert(std::make_pair(missing[i], loaded[i]));
+				decoded++;
+			}
+			pending.erase(missing[i]);
+		}
+	}
+	for(unsigned int i = 0; i < missing.size(); i++)
+		promises[i].set_value(loaded[i]);
+	return decoded;
+}
+
+bool SamplePool::contains(const char *fileName) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return tables.find(fileName) != tables.end();
+}
+
+unsigned int SamplePool::releaseUnused() {
+	std::lock_guard<std::mutex> lock(mutex);
+	unsigned int released = 0;
+	std::map<std::string, SampleTable>::iterator it = tables.begin();
+	while(it != tables.end()) {
+		if(it->second.getReferenceCount() == 1) {
+			tables.erase(it++);
+			released++;
+		} else
+			++it;
+	}
+	return released;
+}
+
+unsigned int SamplePool::getSize() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return tables.size();
+}
+
+size_t SamplePool::getMemoryUsage() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t total = 0;
+	std::map<std::string, SampleTable>::const_iterator it;
+	for(it = tables.begin(); it != tables.end(); ++it)
+		total += it->second.getMemoryUsage();
+	return total;
+}
+
+void SamplePool::printMemoryUsage() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t total = 0;
+	std::map<std::string, SampleTable>::const_iterator it;
+	for(it = tables.begin(); it != tables.end(); ++it) {
+		// The pool's own copy is not counted as a user.
+		std::cout << it->first << ": " << it->second.getMemoryUsage() << " bytes, "
+				<< it->second.getReferenceCount() - 1 << " references" << std::endl;
+		total += it->second.getMemoryUsage();
+	}
+	std::cout << "Files: " << tables.size() << std::endl;
+	std::cout << "Total decoded memory (bytes): " << total << std::endl;
+}
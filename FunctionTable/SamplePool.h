@@ -0,0 +1,74 @@
+/*
+ * SamplePool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef SAMPLEPOOL_H_
+#define SAMPLEPOOL_H_
+
+#include "FunctionTable.h"
+#include "SampleLoader.h"
+#include <map>
+#include <string>
+#include <mutex>
+#include <future>
+
+/**
+ * Pool of decoded sound files. Each file is decoded once; every request for it returns a SampleTable
+ * sharing the same immutable samples, so any number of SampleReaders (voices) playing one file hold a
+ * single copy of its data. Safe to use from several threads.
+ *
+ * Files are decoded without holding the pool lock. A file being decoded has an entry in `pending`, and
+ * requests for it wait for that decode instead of starting another.
+ */
+class SamplePool {
+protected:
+	std::map<std::string, SampleTable> tables;
+	std::map<std::string, std::shared_future<SampleTable> > pending;
+	mutable std::mutex mutex;
+
+public:
+	/**
+	 * Returns the decoded table for `fileName`, decoding it on first use. If the file cannot be opened,
+	 * the returned table is empty, its getErrorNumber() tells why, and nothing is added to the pool.
+	 */
+	SampleTable get(const char *fileName);
+
+	/**
+	 * Decodes every file that is not yet in the pool or being decoded concurrently with `loader`. Returns
+	 * the number of files decoded. Files that cannot be opened are left out of the pool; `loader` reports
+	 * which.
+	 */
+	unsigned int preload(const std::vector<std::string> &files, SampleLoader &loader,
+			SampleLoader::Progress progress = SampleLoader::Progress());
+
+	/**
+	 * True if `fileName` has already been decoded into the pool.
+	 */
+	bool contains(const char *fileName) const;
+
+	/**
+	 * Removes tables that are no longer referenced outside the pool and returns the number removed.
+	 * Tables still held by readers stay valid; their memory is freed when the last copy is destroyed.
+	 */
+	unsigned int releaseUnused();
+
+	/**
+	 * Number of files currently held.
+	 */
+	unsigned int getSize() const;
+
+	/**
+	 * Total size in bytes of the decoded samples held by the pool.
+	 */
+	size_t getMemoryUsage() const;
+
+	/**
+	 * Print per file memory usage and reference counts to the console.
+	 */
+	void printMemoryUsage() const;
+};
+
+#endif /* SAMPLEPOOL_H_ */
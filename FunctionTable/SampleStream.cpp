@@ -0,0 +1,230 @@
+/*
+ * SampleStream.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "SampleStream.h"
+#include <sndfile.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+SampleStream::SampleStream(const char *fileName, long headFrames, long blockFrames, unsigned int numBlocks) :
+		file(NULL), channels(0), samplerate(0), frames(0), headFrames(0), blockFrames(blockFrames),
+		blocks(numBlocks), underrunFrames(0), underrunEvents(0), blocksLoaded(0), running(false) {
+
+	for(int i = 0; i < def_streamreaders; i++)
+		cursors[i].active = false;
+	SF_INFO info;
+	SNDFILE *openFile = sf_open(fileName, SFM_READ, &info);
+	if(openFile == NULL || blockFrames <= 0) {
+		exception.setError(OPEN_FILE_TO_READ, fileName, DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+	file = openFile;
+	channels = info.channels;
+	samplerate = info.samplerate;
+	frames = (long) info.frames;
+	readBuffer.resize(blockFrames * channels);
+	for(unsigned int i = 0; i < blocks.size(); i++) {
+		blocks[i].index = -1;
+		std::vector<std::atomic<double> >(blockFrames * channels).swap(blocks[i].data);
+	}
+
+	this->headFrames = headFrames < frames ? headFrames : frames;
+	head.resize(this->headFrames * channels, 0.0);
+	long count = 0, framesRead;
+	while(count < this->headFrames) {
+		long request = std::min(blockFrames, this->headFrames - count);
+		framesRead = sf_readf_double(openFile, &readBuffer[0], request);
+		if(framesRead <= 0)
+			break;
+		for(int c = 0; c < channels; c++) {
+			double *plane = &head[c * this->headFrames + count];
+			for(long i = 0; i < framesRead; i++)
+				plane[i] = readBuffer[i * channels + c];
+		}
+		count += framesRead;
+	}
+
+	running = true;
+	ioThread = std::thread(&SampleStream::prefetch, this);
+}
+
+SampleStream::~SampleStream() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+	}
+	wakeUp.notify_one();
+	if(ioThread.joinable())
+		ioThread.join();
+	if(file)
+		sf_close((SNDFILE *) file);
+}
+
+int SampleStream::attachReader() {
+	for(int i = 0; i < def_streamreaders; i++) {
+		bool expected = false;
+		if(!cursors[i].active && cursors[i].active.compare_exchange_strong(expected, true)) {
+			cursors[i].position = 0.0;
+			cursors[i].speed = 1.0;
+			return i;
+		}
+	}
+	exception.setError(UNDEFINED_ERROR, "Too many readers attached to stream; reader will not be prefetched",
+			DEBUG_INFO);
+	exception.printErrorToConsole();
+	return -1;
+}
+
+void SampleStream::detachReader(int id) {
+	if(id >= 0 && id < def_streamreaders)
+		cursors[id].active = false;
+}
+
+void SampleStream::setReadPosition(int id, double position, double speed) {
+	if(id < 0 || id >= def_streamreaders)
+		return;
+	cursors[id].position = position;
+	cursors[id].speed = speed;
+	wakeUp.notify_one();
+}
+
+/**
+ * Copies part of a resident block. The block index is checked again after copying so that a block
+ * recycled by the I/O thread while being read is reported as missing rather than returned torn. The
+ * relaxed loads cost the same as plain ones, but keep the overlapping copy well defined.
+ */
+bool SampleStream::copyBlock(long index, long offset, long count, int channel, double *dest) {
+	for(unsigned int b = 0; b < blocks.size(); b++) {
+		if(blocks[b].index.load(std::memory_order_acquire) != index)
+			continue;
+		const std::atomic<double> *src = &blocks[b].data[channel * blockFrames + offset];
+		for(long i = 0; i < count; i++)
+			dest[i] = src[i].load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return blocks[b].index.load(std::memory_order_relaxed) == index;
+	}
+	return false;
+}
+
+const double *SampleStream::readWindow(long start, long count, int channel, double *scratch) {
+	const double *headPlane = head.empty() ? NULL : &head[channel * headFrames];
+	if(start + count <= headFrames)
+		return headPlane + start;
+
+	long missing = 0;
+	long frame = start, end = start + count, run;
+	while(frame < end) {
+		double *dest = scratch + (frame - start);
+		if(frame < headFrames) {
+			run = std::min(end, headFrames) - frame;
+			memcpy(dest, headPlane + frame, run * sizeof(double));
+		} else if(frame >= frames) {
+			run = end - frame;
+			memset(dest, 0, run * sizeof(double));
+		} else {
+			long index = frame / blockFrames;
+			long offset = frame - index * blockFrames;
+			run = std::min(std::min(blockFrames - offset, end - frame), frames - frame);
+			if(!copyBlock(index, offset, run, channel, dest)) {
+				memset(dest, 0, run * sizeof(double));
+				missing += run;
+			}
+		}
+		frame += run;
+	}
+	if(missing) {
+		underrunFrames += missing;
+		underrunEvents++;
+		wakeUp.notify_one();
+	}
+	return scratch;
+}
+
+void SampleStream::loadBlock(Block &block, long index) {
+	block.index.store(-1, std::memory_order_relaxed);
+	// Keeps the writes below from being seen before the block is marked invalid, so a reader that
+	// copies while they happen fails its second index check in copyBlock().
+	std::atomic_thread_fence(std::memory_order_release);
+	long first = index * blockFrames;
+	long request = std::min(blockFrames, frames - first);
+	long framesRead = 0;
+	if(sf_seek((SNDFILE *) file, first, SEEK_SET) == first)
+		framesRead = sf_readf_double((SNDFILE *) file, &readBuffer[0], request);
+	if(framesRead < 0)
+		framesRead = 0;
+	for(int c = 0; c < channels; c++) {
+		std::atomic<double> *plane = &block.data[c * blockFrames];
+		for(long i = 0; i < framesRead; i++)
+			plane[i].store(readBuffer[i * channels + c], std::memory_order_relaxed);
+		for(long i = framesRead; i < blockFrames; i++)
+			plane[i].store(0.0, std::memory_order_relaxed);
+	}
+	block.index.store(index, std::memory_order_release);
+	blocksLoaded++;
+}
+
+/**
+ * I/O thread. Each pass collects the blocks every active reader needs next, nearest first, and loads
+ * the missing ones into ring slots that no reader currently needs.
+ */
+void SampleStream::prefetch() {
+	std::vector<long> wanted;
+	long lastBlock = (frames - 1) / blockFrames;
+
+	while(running) {
+		int active = 0;
+		for(int c = 0; c < def_streamreaders; c++)
+			active += cursors[c].active ? 1 : 0;
+
+		wanted.clear();
+		if(active > 0) {
+			long share = std::max(1L, (long) blocks.size() / active);
+			for(long step = 0; step < share; step++) {
+				for(int c = 0; c < def_streamreaders; c++) {
+					if(!cursors[c].active)
+						continue;
+					double speed = cursors[c].speed;
+					long ahead = (long) ceil(fabs(speed) * samplerate * def_streamlookahead / blockFrames) + 1;
+					if(step >= std::min(ahead, share))
+						continue;
+					long index = (long) cursors[c].position / blockFrames + (speed < 0 ? -step : step);
+					if(index < 0 || index > lastBlock || (index + 1) * blockFrames <= headFrames)
+						continue;
+					if(std::find(wanted.begin(), wanted.end(), index) == wanted.end())
+						wanted.push_back(index);
+				}
+			}
+		}
+
+		for(unsigned int w = 0; w < wanted.size() && running; w++) {
+			bool resident = false;
+			for(unsigned int b = 0; b < blocks.size() && !resident; b++)
+				resident = blocks[b].index == wanted[w];
+			if(resident)
+				continue;
+
+			Block *victim = NULL;
+			for(unsigned int b = 0; b < blocks.size() && victim == NULL; b++) {
+				long index = blocks[b].index;
+				if(index < 0 || std::find(wanted.begin(), wanted.end(), index) == wanted.end())
+					victim = &blocks[b];
+			}
+			if(victim == NULL)
+				break;
+			loadBlock(*victim, wanted[w]);
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		if(running)
+			wakeUp.wait_for(lock, std::chrono::milliseconds(5));
+	}
+}
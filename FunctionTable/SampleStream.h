@@ -0,0 +1,130 @@
+/*
+ * SampleStream.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef SAMPLESTREAM_H_
+#define SAMPLESTREAM_H_
+
+#include "FunctionTable.h"
+#include "AudioException.h"
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Default number of frames decoded into memory when a stream is opened.
+ */
+const long def_streamhead = 65536;
+/**
+ * Default number of frames per prefetch block.
+ */
+const long def_streamblock = 16384;
+/**
+ * Default number of blocks in the prefetch ring.
+ */
+const unsigned int def_streamblocks = 32;
+/**
+ * Default time in seconds of material a reader should have prefetched ahead of its play position.
+ */
+const double def_streamlookahead = 0.5;
+/**
+ * Maximum number of readers that can be attached to one stream.
+ */
+const int def_streamreaders = 16;
+
+/**
+ * Disk-streaming sample source. Only the first `headFrames` of the file are decoded when the stream is
+ * opened. A background I/O thread keeps a ring of blocks filled with the regions that attached
+ * SampleReaders will reach next, based on the play position and speed each reader reports.
+ *
+ * Underrun behaviour: frames that are requested before their block has been loaded read as silence. Each
+ * such request increments the underrun counters; playback position is not affected, so the reader resumes
+ * normally once the block arrives.
+ *
+ * Blocks hold every channel of the file, one plane per channel. Their samples are atomics written and
+ * read with relaxed ordering, so a reader copying a block while the I/O thread refills it reads stale or
+ * new values rather than racing, and the block's index tells it to discard them.
+ */
+class SampleStream : public AudioException, public SampleSource {
+protected:
+	struct Block {
+		std::atomic<long> index;
+		std::vector<std::atomic<double> > data;
+	};
+
+	struct Cursor {
+		std::atomic<bool> active;
+		std::atomic<double> position;
+		std::atomic<double> speed;
+	};
+
+	void *file;
+	int channels;
+	double samplerate;
+	long frames;
+	long headFrames;
+	long blockFrames;
+	std::vector<double> head;
+	std::vector<Block> blocks;
+	Cursor cursors[def_streamreaders];
+	std::vector<double> readBuffer;
+	AudioException exception;
+
+	std::atomic<unsigned long> underrunFrames;
+	std::atomic<unsigned long> underrunEvents;
+	std::atomic<unsigned long> blocksLoaded;
+
+	std::atomic<bool> running;
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::thread ioThread;
+
+	void prefetch();
+	void loadBlock(Block &block, long index);
+	bool copyBlock(long index, long offset, long count, int channel, double *dest);
+
+public:
+	/**
+	 * Opens a sound file for streaming.
+	 * @param fileName File to stream.
+	 * @param headFrames Number of frames preloaded at construction.
+	 * @param blockFrames Size of a prefetch block in frames.
+	 * @param numBlocks Number of blocks in the prefetch ring.
+	 */
+	SampleStream(const char *fileName, long headFrames = def_streamhead,
+			long blockFrames = def_streamblock, unsigned int numBlocks = def_streamblocks);
+
+	~SampleStream();
+
+	int getChannels() { return channels; }
+	double getSampleRate() { return samplerate; }
+	long getFrames() { return frames; }
+
+	const double *readWindow(long start, long count, int channel, double *scratch);
+
+	int attachReader();
+	void detachReader(int id);
+	void setReadPosition(int id, double position, double speed);
+
+	/**
+	 * Total number of frames that were output as silence because their block was not resident.
+	 */
+	unsigned long getUnderrunFrames() const { return underrunFrames; }
+
+	/**
+	 * Number of readWindow() calls that hit at least one missing block.
+	 */
+	unsigned long getUnderrunEvents() const { return underrunEvents; }
+
+	/**
+	 * Number of blocks decoded by the I/O thread.
+	 */
+	unsigned long getBlocksLoaded() const { return blocksLoaded; }
+};
+
+#endif /* SAMPLESTREAM_H_ */
@@ -0,0 +1,129 @@
+/*
+ * SincKernel.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "SincKernel.h"
+#include "AudioBase.h"
+#include <cmath>
+#include <stdint.h>
+#include <algorithm>
+
+namespace {
+
+const double kaiserBeta = 8.0;
+const double rolloff = 0.95;
+
+double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for(int k = 1; k < 50; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if(term < sum * 1e-17)
+			break;
+	}
+	return sum;
+}
+
+}
+
+SincKernel::SincKernel(unsigned int taps, unsigned int phases) : taps(taps), phases(phases) {
+	int half = taps / 2;
+
+	// Prototype kernel sampled at x = i / phases - half, covering its whole support.
+	prototype.resize(taps * phases + 2, 0.0);
+	for(unsigned int i = 0; i <= taps * phases; i++) {
+		double x = (double) i / phases - half;
+		double sinc = x == 0 ? 1.0 : sin(PI * rolloff * x) / (PI * rolloff * x);
+		double w = x / half;
+		double window = fabs(w) < 1 ? besselI0(kaiserBeta * sqrt(1 - w * w)) / besselI0(kaiserBeta) : 0.0;
+		prototype[i] = rolloff * sinc * window;
+	}
+
+	// Polyphase rows. Tap k of row p multiplies x[k - half + 1] for a fraction of p / phases.
+	rows.resize((phases + 1) * taps);
+	for(unsigned int p = 0; p <= phases; p++)
+		for(unsigned int k = 0; k < taps; k++)
+			rows[p * taps + k] = prototype[(half - 1 - k + half) * phases + p];
+}
+
+const SincKernel &SincKernel::get(INTERPOLATION quality) {
+	switch(quality) {
+	case INTERP_SINC32: {
+		static const SincKernel sinc32(INTERP_SINC32);
+		return sinc32;
+	}
+	case INTERP_SINC16: {
+		static const SincKernel sinc16(INTERP_SINC16);
+		return sinc16;
+	}
+	default: {
+		static const SincKernel sinc8(INTERP_SINC8);
+		return sinc8;
+	}
+	}
+}
+
+double SincKernel::interpolate(const double *x, double frac) const {
+	double pos = frac * phases;
+	unsigned int p = (unsigned int) pos;
+	double a = pos - p;
+	const double *row0 = &rows[p * taps];
+	const double *row1 = row0 + taps;
+	const double *in = x + 1 - (int)(taps / 2);
+
+	// Independent partial sums let the compiler keep the dot products in vector registers.
+	double s0[4] = {0, 0, 0, 0}, s1[4] = {0, 0, 0, 0};
+	for(unsigned int k = 0; k < taps; k += 4) {
+		for(unsigned int j = 0; j < 4; j++) {
+			s0[j] += in[k + j] * row0[k + j];
+			s1[j] += in[k + j] * row1[k + j];
+		}
+	}
+	double y0 = (s0[0] + s0[1]) + (s0[2] + s0[3]);
+	double y1 = (s1[0] + s1[1]) + (s1[2] + s1[3]);
+	return y0 + a * (y1 - y0);
+}
+
+double SincKernel::interpolate(const double *x, double frac, double step) const {
+	if(step <= 1.0)
+		return interpolate(x, frac);
+	if(step > def_maxdecimation)
+		step = def_maxdecimation;
+	double scale = 1.0 / step;
+	int reach = getReach(step);
+
+	// Tap n uses the prototype at table position start - n * stride. Only taps with a position inside
+	// the kernel's support are visited, so the loop needs no bounds checks, and the position is walked in
+	// 32.32 fixed point: each coefficient is a linear blend of two neighbouring table phases.
+	double end = (double) taps * phases;
+	double start = (frac * scale + taps / 2) * phases;
+	double stride = scale * phases;
+	int first = std::max(1 - reach, (int) floor((start - end) / stride) + 1);
+	int last = std::min(reach, (int) ceil(start / stride) - 1);
+	if(first > last)
+		return 0.0;
+
+	const double fixedOne = 4294967296.0;
+	uint64_t position = (uint64_t)(std::max(start - last * stride, 0.0) * fixedOne);
+	uint64_t increment = (uint64_t)(stride * fixedOne);
+	// Two partial sums, alternating by tap, halve the dependency chain of the additions.
+	double sum[2] = {0.0, 0.0};
+	for(int n = last; n >= first; n--) {
+		const double *p = &prototype[position >> 32];
+		double a = (double)(position & 0xffffffffu) * (1.0 / fixedOne);
+		sum[n & 1] += x[n] * (p[0] + a * (p[1] - p[0]));
+		position += increment;
+	}
+	return (sum[0] + sum[1]) * scale;
+}
+
+int SincKernel::getReach(INTERPOLATION quality, double step) {
+	if(step < 1.0)
+		step = 1.0;
+	if(step > def_maxdecimation)
+		step = def_maxdecimation;
+	return (int) ceil(quality / 2 * step);
+}
@@ -0,0 +1,81 @@
+/*
+ * SincKernel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef SINCKERNEL_H_
+#define SINCKERNEL_H_
+
+#include <vector>
+
+/**
+ * Interpolation used by SampleReader. The sinc settings are quality/CPU tiers given by their kernel
+ * length in taps.
+ */
+enum INTERPOLATION {
+	INTERP_LINEAR = 2,
+	INTERP_SINC8 = 8,
+	INTERP_SINC16 = 16,
+	INTERP_SINC32 = 32
+};
+
+/**
+ * Number of kernel phases per sample interval in the polyphase tables.
+ */
+const unsigned int def_sincphases = 256;
+/**
+ * Largest playback increment for which the kernel is widened to suppress aliasing. Faster playback
+ * uses this factor, trading some aliasing for a bounded cost per sample.
+ */
+const double def_maxdecimation = 8.0;
+
+/**
+ * Kaiser windowed sinc interpolation kernel, precomputed as a polyphase table. Row `p` holds the `taps`
+ * coefficients for a fractional position of p / def_sincphases, stored contiguously so interpolating a
+ * sample is a short dot product. Kernels are shared: use get() to obtain the table for a tier. Each tier
+ * is built on its first get(), so only the tiers in use cost memory and setup time.
+ */
+class SincKernel {
+protected:
+	unsigned int taps;
+	unsigned int phases;
+	std::vector<double> rows;
+	std::vector<double> prototype;
+
+	SincKernel(unsigned int taps, unsigned int phases = def_sincphases);
+
+public:
+	/**
+	 * Returns the shared kernel for an interpolation tier. `quality` must be one of the INTERP_SINC values.
+	 */
+	static const SincKernel &get(INTERPOLATION quality);
+
+	unsigned int getTaps() const { return taps; }
+
+	/**
+	 * Interpolates between `x[0]` and `x[1]` at fraction `frac`. `x` must be readable from
+	 * `x[1 - taps / 2]` to `x[taps / 2]`.
+	 */
+	double interpolate(const double *x, double frac) const;
+
+	/**
+	 * Band-limited interpolation at `x[0] + frac` for a playback increment `step` > 1. The kernel is
+	 * stretched by `step` (up to def_maxdecimation) so that content above the new Nyquist frequency is
+	 * removed. `x` must be readable within getReach(step) samples on either side.
+	 */
+	double interpolate(const double *x, double frac, double step) const;
+
+	/**
+	 * Number of input samples needed on each side of the interpolation point for a playback increment.
+	 */
+	int getReach(double step) const { return getReach((INTERPOLATION) taps, step); }
+
+	/**
+	 * getReach() of the kernel for an interpolation tier, without building the kernel.
+	 */
+	static int getReach(INTERPOLATION quality, double step);
+};
+
+#endif /* SINCKERNEL_H_ */
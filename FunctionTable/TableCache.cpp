@@ -0,0 +1,196 @@
+/*
+ * TableCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "TableCache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+/**
+ * Layout of a cache file: this header, then `amplitudes` doubles of the amplitude array the table was
+ * generated from, then `size + 2` doubles (table and guard points). Tables generated from a waveform
+ * type store no amplitudes; tables generated from an amplitude array store `type` as `arrayType`.
+ */
+struct CacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t size;
+	uint32_t harmonics;
+	uint32_t type;
+	double phase;
+	uint32_t normalize;
+	uint32_t amplitudes;
+};
+
+const char cacheMagic[8] = {'A', 'B', 'F', 'T', 'A', 'B', 'L', 'E'};
+
+const uint32_t arrayType = 0xffffffff;
+
+uint64_t hashBytes(const void *data, size_t length, uint64_t hash = 14695981039346656037ULL) {
+	const unsigned char *bytes = (const unsigned char *) data;
+	for(size_t i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+}
+
+CachedTable::CachedTable(const char *cacheDir, const unsigned int harmonics, const double *ampArray,
+		const double phase, const unsigned int size, bool norm) :
+		FuncTable(NULL, size), mapping(NULL), mappingSize(0), harmonics(harmonics), type(arrayType),
+		phase(phase) {
+
+	normalize = norm;
+	if(ampArray != NULL)
+		amplitudes.assign(ampArray, ampArray + harmonics);
+	setPath(cacheDir);
+	if(!mapFile()) {
+		FourierTable generated(harmonics, ampArray, phase, size);
+		store(generated, norm);
+	}
+}
+
+CachedTable::CachedTable(const char *cacheDir, const unsigned int harmonics, const unsigned int type,
+		const double phase, const unsigned int size, bool norm) :
+		FuncTable(NULL, size), mapping(NULL), mappingSize(0), harmonics(harmonics), type(type),
+		phase(phase) {
+
+	normalize = norm;
+	setPath(cacheDir);
+	if(!mapFile()) {
+		FourierTable generated(harmonics, type, phase, size);
+		store(generated, norm);
+	}
+}
+
+CachedTable::~CachedTable() {
+	if(mapping != NULL)
+		munmap(mapping, mappingSize);
+}
+
+/**
+ * Names the cache file after a hash of the generator parameters. Different parameters may share a name;
+ * the header tells them apart, and the newer table replaces the older file.
+ */
+void CachedTable::setPath(const char *cacheDir) {
+	uint64_t hash = hashBytes(&def_cacheversion, sizeof(def_cacheversion));
+	hash = hashBytes(&harmonics, sizeof(harmonics), hash);
+	hash = hashBytes(&type, sizeof(type), hash);
+	hash = hashBytes(&phase, sizeof(phase), hash);
+	hash = hashBytes(&size, sizeof(size), hash);
+	hash = hashBytes(&normalize, sizeof(normalize), hash);
+	if(!amplitudes.empty())
+		hash = hashBytes(&amplitudes[0], amplitudes.size() * sizeof(double), hash);
+
+	char name[32];
+	snprintf(name, sizeof(name), "/ftab-%016llx.bin", (unsigned long long) hash);
+	path = std::string(cacheDir) + name;
+	mappingSize = sizeof(CacheHeader) + (amplitudes.size() + size + 2) * sizeof(double);
+}
+
+/**
+ * Maps an existing cache file. Files whose header, amplitudes or length do not match this table's
+ * parameters are ignored and regenerated.
+ */
+bool CachedTable::mapFile() {
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return false;
+
+	struct stat st;
+	if(fstat(fd, &st) != 0 || (size_t) st.st_size != mappingSize) {
+		close(fd);
+		return false;
+	}
+	void *data = mmap(NULL, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(data == MAP_FAILED)
+		return false;
+
+	const CacheHeader *header = (const CacheHeader *) data;
+	const double *amps = (const double *)((const char *) data + sizeof(CacheHeader));
+	if(memcmp(header->magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+			header->version != def_cacheversion || header->size != size || header->harmonics != harmonics ||
+			header->type != type || header->phase != phase || header->normalize != (uint32_t) normalize ||
+			header->amplitudes != amplitudes.size() ||
+			(!amplitudes.empty() && memcmp(amps, &amplitudes[0], amplitudes.size() * sizeof(double)) != 0)) {
+		munmap(data, mappingSize);
+		return false;
+	}
+
+	if(owner)
+		delete[] table;
+	mapping = data;
+	owner = false;
+	table = (double *)(amps + amplitudes.size());
+	return true;
+}
+
+/**
+ * Writes the table to a temporary file and renames it into place, so concurrent writers never expose
+ * a partially written file. mkstemp() gives every writer, in any process or thread, its own file.
+ */
+bool CachedTable::writeFile(const double *data) {
+	CacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+	header.version = def_cacheversion;
+	header.size = size;
+	header.harmonics = harmonics;
+	header.type = type;
+	header.phase = phase;
+	header.normalize = normalize;
+	header.amplitudes = amplitudes.size();
+
+	std::string tmpPath = path + ".XXXXXX";
+	int fd = mkstemp(&tmpPath[0]);
+	if(fd < 0)
+		return false;
+
+	size_t ampSize = amplitudes.size() * sizeof(double);
+	size_t dataSize = (size + 2) * sizeof(double);
+	bool ok = fchmod(fd, 0644) == 0 && write(fd, &header, sizeof(header)) == (ssize_t) sizeof(header) &&
+			(ampSize == 0 || write(fd, &amplitudes[0], ampSize) == (ssize_t) ampSize) &&
+			write(fd, data, dataSize) == (ssize_t) dataSize;
+	ok = close(fd) == 0 && ok;
+	if(ok)
+		ok = rename(tmpPath.c_str(), path.c_str()) == 0;
+	if(!ok)
+		unlink(tmpPath.c_str());
+	return ok;
+}
+
+/**
+ * Stores a freshly generated table. The result is mapped from the cache when possible and kept in
+ * private memory otherwise.
+ */
+void CachedTable::store(FuncTable &generated, bool norm) {
+	table = new double[size + 2];
+	owner = true;
+	memcpy(table, generated.getTable(), size * sizeof(double));
+	if(norm)
+		normalizeTable();
+	//Wrap around points for linear and cubic interpolation.
+	table[size] = table[0];
+	table[size+1] = table[1];
+
+	if(!writeFile(table)) {
+		setError(OPEN_FILE_TO_WRITE, path, DEBUG_INFO);
+		return;
+	}
+	mapFile();
+}
@@ -0,0 +1,75 @@
+/*
+ * TableCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef TABLECACHE_H_
+#define TABLECACHE_H_
+
+#include "FunctionTable.h"
+#include "AudioException.h"
+#include <string>
+#include <vector>
+
+/**
+ * Version of the table generators and the cache file layout. Must be incremented whenever generated
+ * table contents change, so that stale cache files are ignored.
+ */
+const unsigned int def_cacheversion = 2;
+
+/**
+ * Function table backed by an on-disk cache. The table is identified by its generator parameters and
+ * `def_cacheversion`, which are all stored in the file header and compared in full before a file is
+ * used; the file name is only a hash of them. If a matching cache file exists in `cacheDir` it is memory-mapped read-only and
+ * used directly, so every process on the host shares the same physical pages. Otherwise the table is
+ * generated, written to the cache and then mapped.
+ *
+ * If the cache directory is not writable, the table is kept in private memory and the error is
+ * recorded (see AudioException); processing is not interrupted.
+ */
+class CachedTable : public FuncTable, public AudioException {
+protected:
+	void *mapping;
+	size_t mappingSize;
+	std::string path;
+	unsigned int harmonics;
+	unsigned int type;
+	double phase;
+	std::vector<double> amplitudes;
+
+	void setPath(const char *cacheDir);
+	bool mapFile();
+	bool writeFile(const double *data);
+	void store(FuncTable &generated, bool norm);
+
+public:
+	/**
+	 * Cached equivalent of FourierTable(harmonics, ampArray, phase, size), optionally normalized.
+	 * @param cacheDir Directory holding cache files. Must exist.
+	 */
+	CachedTable(const char *cacheDir, const unsigned int harmonics, const double *ampArray,
+			const double phase = 0., const unsigned int size = def_tsize, bool norm = false);
+
+	/**
+	 * Cached equivalent of FourierTable(harmonics, type, phase, size), optionally normalized.
+	 * @param cacheDir Directory holding cache files. Must exist.
+	 */
+	CachedTable(const char *cacheDir, const unsigned int harmonics, const unsigned int type,
+			const double phase = 0., const unsigned int size = def_tsize, bool norm = false);
+
+	~CachedTable();
+
+	/**
+	 * True if the samples are served from a shared read-only mapping of the cache file.
+	 */
+	bool isMapped() const { return mapping != NULL; }
+
+	/**
+	 * Path of the cache file for this table.
+	 */
+	const char *getPath() const { return path.c_str(); }
+};
+
+#endif /* TABLECACHE_H_ */
@@ -8,8 +8,9 @@
 #include "Oscillator.h"
 #include <cstdlib>
 #include "FunctionTable.h"
+#include "ConstTables.h"
 
-const SinTable Oscil::sinTab;
+const FuncTable Oscil::sinTab(sineTable);
 
 void Oscil::oscillator() {
 	for (unsigned int i = 0; i < getVectorSize(); i++) {
@@ -17,6 +18,7 @@ void Oscil::oscillator() {
 		vector[i] = amplitude * table[(int) phase];
 		updatePhase();
 	}
+	checkSilence();
 }
 
 void Oscili::oscillator() {
@@ -29,6 +31,7 @@ void Oscili::oscillator() {
 		vector[i] = amplitude * (table[posi] + frac * (table[posi + 1] - table[posi]));
 		updatePhase();
 	}
+	checkSilence();
 }
 
 void Oscilc::oscillator() {
@@ -52,6 +55,7 @@ void Oscilc::oscillator() {
 						+ frac * (c + (-2.f * a - tmp) / 6.f) + b);
 		updatePhase();
 	}
+	checkSilence();
 }
 
 inline void Oscil::updatePhase(){
@@ -95,6 +99,7 @@ void WhiteNoise::generate() {
 		checkModulation(i);
 		vector[i] = amplitude * ((rand() % 2001 / 1000.0) - 1);
 	}
+	silent = ampMod != NULL ? ampSilent : amplitude == 0.0;
 }
 
 void WhiteNoise::checkModulation(int index) {
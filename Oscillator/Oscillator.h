@@ -17,25 +17,31 @@ class Oscil : public AudioBuffer{
 
 protected:
 
-	const static SinTable sinTab;
+	const static FuncTable sinTab;
 	double amplitude;
 	double frequency;
-	double *table;
+	const double *table;
 	int size;
 	double phase;
 	const double *ampMod;
 	const double *freqMod;
+	bool ampSilent;
 
 	void updatePhase();
 	void checkModulation(int index);
 
+	/**
+	 * Marks the output silent when the amplitude is zero for the whole block.
+	 */
+	void checkSilence() { silent = ampMod != NULL ? ampSilent : amplitude == 0.0; }
+
 public:
 
 	virtual void oscillator();
 
 	Oscil(double a, double f, const FuncTable &t = sinTab, double phs = 0.) :
 			amplitude(a), frequency(f), table(t.getTable()), size(t.getSize()),
-			phase(phs), ampMod(NULL), freqMod(NULL) {
+			phase(phs), ampMod(NULL), freqMod(NULL), ampSilent(false) {
 	}
 
 	virtual ~Oscil() {
@@ -62,12 +68,14 @@ public:
 
 	virtual const Oscil &process(const AudioBuffer &obja) {
 		ampMod = obja.getVector();
+		ampSilent = obja.isSilent();
 		oscillator();
 		return *this;
 	}
 
 	virtual const Oscil &process(const AudioBuffer &obja, float f) {
 		ampMod = obja.getVector();
+		ampSilent = obja.isSilent();
 		frequency = f;
 		oscillator();
 		return *this;
@@ -75,6 +83,7 @@ public:
 
 	virtual const Oscil &process(const AudioBuffer &obja,const AudioBuffer &objf) {
 		ampMod = obja.getVector();
+		ampSilent = obja.isSilent();
 		freqMod = objf.getVector();
 		oscillator();
 		return *this;
@@ -134,7 +143,7 @@ public:
 class TableReader : public AudioParams {
 
 protected:
-	double *refTable;
+	const double *refTable;
 	int size;
 	bool normalized;
 	bool wrap;
@@ -154,12 +163,13 @@ class WhiteNoise : public AudioBuffer {
 protected:
 	double amplitude;
 	const double *ampMod;
+	bool ampSilent;
 
 	virtual void generate();
 	virtual void checkModulation(int index);
 
 public:
-	WhiteNoise(const double amplitude = 0.5) : amplitude(amplitude), ampMod(NULL) {}
+	WhiteNoise(const double amplitude = 0.5) : amplitude(amplitude), ampMod(NULL), ampSilent(false) {}
 
 	virtual ~WhiteNoise() {}
 
@@ -176,6 +186,7 @@ public:
 
 	const AudioBuffer &process(const AudioBuffer &buffer) {
 		ampMod = buffer.getVector();
+		ampSilent = buffer.isSilent();
 		generate();
 		return *this;
 	}
@@ -0,0 +1,174 @@
+/*
+ * FDN.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#include "FDN.h"
+#include "Denormal.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+namespace {
+
+bool isPrime(unsigned int n) {
+	if(n < 2)
+		return false;
+	for(unsigned int d = 2; d * d <= n; d++)
+		if(n % d == 0)
+			return false;
+	return true;
+}
+
+}
+
+FDNReverb::FDNReverb(double decay, unsigned int lines, FDN_MATRIX matrix, double size) :
+		lines(lines), matrix(matrix), decayTime(decay), damping(0.0), lengths(lines), gains(lines),
+		filterState(lines, 0.0), delayLines(lines), rows(lines * getVectorSize(), 0.0),
+		scratch(getVectorSize(), 0.0), writePosition(0) {
+	if(lines != 4 && lines != 8 && lines != 16) {
+		exception.setError(SIZE_MISMATCH, "FDN reverb needs 4, 8 or 16 lines", DEBUG_INFO);
+		exception.printErrorToConsole();
+		exit(exception.getErrorNumber());
+	}
+
+	// Line lengths spread exponentially from 31 ms to 97 ms, then moved up to distinct primes so that
+	// echoes of different lines rarely coincide.
+	for(unsigned int j = 0; j < lines; j++) {
+		double seconds = 0.031 * pow(0.097 / 0.031, (double) j / (lines - 1)) * size;
+		unsigned int length = std::max((unsigned int)(seconds * getSrate()), getVectorSize());
+		while(!isPrime(length) || (j > 0 && length <= lengths[j - 1]))
+			length++;
+		lengths[j] = length;
+		delayLines[j].allocate(length);
+	}
+	updateGains();
+}
+
+void FDNReverb::updateGains() {
+	for(unsigned int j = 0; j < lines; j++)
+		gains[j] = Delay::getFeedbackFromDecay(decayTime, (double) lengths[j] / getSrate());
+}
+
+void FDNReverb::setDecay(double decay) {
+	decayTime = decay;
+	updateGains();
+}
+
+void FDNReverb::setDamping(double damping) {
+	this->damping = std::min(std::max(damping, 0.0), 0.99);
+}
+
+/**
+ * Applies the feedback matrix to the rows in place. Each butterfly or update is a loop over the block.
+ */
+void FDNReverb::mix() {
+	const unsigned int vsize = getVectorSize();
+	if(matrix == FDN_HADAMARD) {
+		for(unsigned int half = 1; half < lines; half <<= 1) {
+			for(unsigned int start = 0; start < lines; start += 2 * half) {
+				for(unsigned int j = start; j < start + half; j++) {
+					double *a = &rows[j * vsize];
+					double *b = &rows[(j + half) * vsize];
+					for(unsigned int i = 0; i < vsize; i++) {
+						double x = a[i], y = b[i];
+						a[i] = x + y;
+						b[i] = x - y;
+					}
+				}
+			}
+		}
+		double scale = 1.0 / sqrt((double) lines);
+		for(unsigned int k = 0; k < lines * vsize; k++)
+			rows[k] *= scale;
+	} else {
+		double scale = 2.0 / lines;
+		double *sum = &scratch[0];
+		std::fill(sum, sum + vsize, 0.0);
+		for(unsigned int j = 0; j < lines; j++) {
+			const double *row = &rows[j * vsize];
+			for(unsigned int i = 0; i < vsize; i++)
+				sum[i] += row[i];
+		}
+		for(unsigned int j = 0; j < lines; j++) {
+			double *row = &rows[j * vsize];
+			for(unsigned int i = 0; i < vsize; i++)
+				row[i] -= scale * sum[i];
+		}
+	}
+}
+
+/**
+ * Every line's gain gives the same decay per second and the matrix is orthogonal, so the network decays
+ * no slower than its slowest line.
+ */
+unsigned long FDNReverb::getTailLength() const {
+	unsigned long tail = 0;
+	for(unsigned int j = 0; j < lines; j++)
+		tail = std::max(tail, loopTail(lengths[j], gains[j]));
+	return tail;
+}
+
+const AudioBuffer &FDNReverb::process(const AudioBuffer &signal) {
+	const unsigned int vsize = getVectorSize();
+	if(silence.update(signal.isSilent(), getTailLength())) {
+		if(!silent) {
+			std::fill(filterState.begin(), filterState.end(), 0.0);
+			left.setSilence();
+			right.setSilence();
+			setSilence();
+		}
+		return *this;
+	}
+	silent = false;
+	const double *in = signal.getVector();
+	double *l = writableData(left), *r = writableData(right);
+
+	// Read every line. Lines are at least a block long, so this block's writes are never read back here.
+	for(unsigned int j = 0; j < lines; j++) {
+		const MirrorRing<double> &line = delayLines[j];
+		const double *src = line.data() + ((writePosition - lengths[j]) & line.getMask());
+		std::copy(src, src + vsize, &rows[j * vsize]);
+	}
+
+	// Stereo outputs from even and odd lines, with alternating signs to reduce correlation.
+	std::fill(l, l + vsize, 0.0);
+	std::fill(r, r + vsize, 0.0);
+	for(unsigned int j = 0; j < lines; j++) {
+		const double *row = &rows[j * vsize];
+		double *dest = j % 2 == 0 ? l : r;
+		double sign = (j / 2) % 2 == 0 ? 1.0 : -1.0;
+		for(unsigned int i = 0; i < vsize; i++)
+			dest[i] += sign * row[i];
+	}
+	for(unsigned int i = 0; i < vsize; i++)
+		vector[i] = l[i] + r[i];
+
+	// Decay gain and one pole damping per line.
+	for(unsigned int j = 0; j < lines; j++) {
+		double *row = &rows[j * vsize];
+		double g = gains[j] * (1.0 - damping), state = filterState[j];
+		for(unsigned int i = 0; i < vsize; i++) {
+			state = g * row[i] + damping * state;
+			row[i] = state;
+		}
+		filterState[j] = flushDenormal(state);
+	}
+
+	mix();
+
+	for(unsigned int j = 0; j < lines; j++) {
+		MirrorRing<double> &line = delayLines[j];
+		const unsigned int write = writePosition & line.getMask();
+		double *dest = line.data() + write;
+		const double *row = &rows[j * vsize];
+		double sign = j % 2 == 0 ? 1.0 : -1.0;
+		for(unsigned int i = 0; i < vsize; i++)
+			dest[i] = flushDenormal(row[i] + sign * in[i]);
+		line.commit(write, vsize);
+	}
+	writePosition += vsize;
+	return *this;
+}
@@ -0,0 +1,110 @@
+/*
+ * FDN.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+#ifndef FDN_H_
+#define FDN_H_
+
+#include "AudioBase.h"
+#include "Delay.h"
+#include "MirrorRing.h"
+#include "Silence.h"
+#include <vector>
+
+/**
+ * Feedback matrix of an FDNReverb.
+ * FDN_HADAMARD - Normalized Hadamard matrix. Mixes every line into every other one with equal weight.
+ * FDN_HOUSEHOLDER - Householder reflection I - 2/N. Cheaper, with less mixing per pass.
+ */
+enum FDN_MATRIX {
+	FDN_HADAMARD = 0,
+	FDN_HOUSEHOLDER
+};
+
+/**
+ * Largest number of delay lines in an FDNReverb.
+ */
+const unsigned int def_fdnmaxlines = 16;
+
+/**
+ * Feedback delay network reverb. N delay lines of mutually prime lengths are read, low pass filtered,
+ * scaled so that each decays by 60 dB in the decay time (see Delay::getFeedbackFromDecay()), mixed by an
+ * orthogonal matrix and written back together with the input. Echo density grows with every pass through
+ * the matrix, so the tail is much denser than SReverb's at a similar cost.
+ *
+ * Every line is at least a block long, so each block is processed a stage at a time across all lines:
+ * read every line, filter, mix, write. The Hadamard matrix is applied as a fast Walsh-Hadamard transform,
+ * N log N additions per sample, with each butterfly running over a whole block.
+ *
+ * Each line is a MirrorRing of its own length rounded up to a power of two, so every block's read and
+ * write is one contiguous window. The rings are mapped in the constructor and take physical memory only
+ * as the lines first write to them.
+ *
+ * The output vector is the sum of all lines. getChannel() gives a decorrelated stereo pair made from the
+ * even and the odd lines.
+ */
+class FDNReverb : public AudioBuffer {
+protected:
+	unsigned int lines;
+	FDN_MATRIX matrix;
+	double decayTime;
+	double damping;
+	std::vector<unsigned int> lengths;
+	std::vector<double> gains;
+	std::vector<double> filterState;
+	std::vector<MirrorRing<double> > delayLines;
+	std::vector<double> rows;
+	std::vector<double> scratch;
+	unsigned int writePosition;
+	AudioBuffer left;
+	AudioBuffer right;
+	SilenceTracker silence;
+
+	void updateGains();
+	void mix();
+
+public:
+	/**
+	 * @param decay Time in seconds for the tail to decay by 60 dB.
+	 * @param lines Number of delay lines: 4, 8 or 16.
+	 * @param matrix Feedback matrix.
+	 * @param size Scale factor for the delay lengths, i.e. the apparent room size.
+	 */
+	FDNReverb(double decay = 3.0, unsigned int lines = 8, FDN_MATRIX matrix = FDN_HADAMARD, double size = 1.0);
+
+	virtual ~FDNReverb() {}
+
+	void setDecay(double decay);
+
+	double getDecay() const { return decayTime; }
+
+	/**
+	 * High frequency damping from 0 (none) to 1 (heavy). High frequencies then decay faster than the
+	 * decay time.
+	 */
+	void setDamping(double damping);
+
+	double getDamping() const { return damping; }
+
+	unsigned int getLines() const { return lines; }
+
+	/**
+	 * Samples for the tail to fall below `def_silence`, about twice the decay time. Once the input has
+	 * been silent this long the network is skipped.
+	 */
+	unsigned long getTailLength() const;
+
+	/**
+	 * Stereo output from the last process() call: 0 for left, 1 for right.
+	 */
+	const AudioBuffer &getChannel(int channel) const { return channel == 0 ? left : right; }
+
+	const AudioBuffer &process(const AudioBuffer &signal);
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+#endif /* FDN_H_ */
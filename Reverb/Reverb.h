@@ -9,41 +9,120 @@
 #define REVERB_H_
 
 #include "delay.h"
+#include "MultiTap.h"
+#include "CombBank.h"
 
-class SReverb : public Delay {
+/**
+ * Comb delay times of SReverb in seconds.
+ */
+const double def_reverbcombs[4] = { 0.0297, 0.0371, 0.0437, 0.0437 };
+
+/**
+ * Default offset in seconds between the left and right delay times of StereoReverb.
+ */
+const double def_stereospread = 0.00052;
+
+/**
+ * Schroeder reverb: four parallel combs followed by two allpasses in series. The combs are updated
+ * together as lanes of one CombBank.
+ *
+ * With `sharedLine` set, the comb section is a single MultiTapDelay with one tap per comb. The input is
+ * written once and each tap feeds back a quarter of the gain its comb would use. The decay time stays
+ * close to that of separate combs, the echo pattern is denser and the tail is somewhat quieter, and
+ * only one delay line is written.
+ *
+ * Only the comb section in use allocates delay lines: the CombBank gets no combs when `sharedLine` is
+ * set, and the MultiTapDelay gets no taps and so no buffer when it is not. Each line is a ring of its own
+ * delay rounded up to a power of two and to whole pages, and takes physical memory as it is first written.
+ */
+class SReverb : public AudioBuffer {
 
 	double decayTime;
-	Delay delay1;
-	Delay delay2;
-	Delay delay3;
-	Delay delay4;
+	CombBank combs;
 	Allpass apass1;
 	Allpass apass2;
+	MultiTapDelay taps;
+	bool sharedLine;
 
 public:
-	SReverb(double decay = 3) : Delay::Delay(1.0),
+	SReverb(double decay = 3, bool sharedLine = false) :
 		decayTime(decay),
-		delay1(0.0297),
-		delay2(0.0371),
-		delay3(0.0437),
-		delay4(0.0437), apass1(0.005), apass2(0.0017) {
-		delay1.setFeedback(delay1.getFeedbackFromDecay(decayTime));
-		delay2.setFeedback(delay2.getFeedbackFromDecay(decayTime));
-		delay3.setFeedback(delay3.getFeedbackFromDecay(decayTime));
-		delay4.setFeedback(delay4.getFeedbackFromDecay(decayTime));
+		combs(std::vector<double>(def_reverbcombs, def_reverbcombs + (sharedLine ? 0 : 4))),
+		apass1(0.005), apass2(0.0017),
+		taps(sharedLine ? 0.0437 : 0.0), sharedLine(sharedLine) {
+		combs.setDecay(decayTime);
 		apass1.setFeedback(apass1.getFeedbackFromDecay(0.0968));
 		apass2.setFeedback(apass2.getFeedbackFromDecay(0.0329));
+		if(sharedLine) {
+			for(int i = 0; i < 4; i++)
+				taps.addTap(def_reverbcombs[i], 1.0, Delay::getFeedbackFromDecay(decayTime, def_reverbcombs[i]) / 4);
+		}
+	}
+
+	const AudioBuffer &process(const AudioBuffer &signal) {
+		const AudioBuffer &parallel = sharedLine ? taps(signal) : combs(signal);
+		const AudioBuffer &out = apass2(apass1(parallel));
+		// Once every stage has gone idle, the output is already silent.
+		if(!(silent && out.isSilent()))
+			fillVector(out);
+		return *this;
+	}
+
+	const AudioBuffer &operator()(const AudioBuffer &signal) { return process(signal); }
+};
+
+/**
+ * Stereo Schroeder reverb from a mono input. Left and right each have four combs and two allpasses as
+ * in SReverb, with the right channel's delay times longer by `spread`, so the two tails are
+ * decorrelated. All eight combs run as lanes of one CombBank.
+ *
+ * The vector holds the sum of both channels. getChannel() gives each channel on its own.
+ */
+class StereoReverb : public AudioBuffer {
+
+	double decayTime;
+	CombBank combs;
+	Allpass apassL1;
+	Allpass apassL2;
+	Allpass apassR1;
+	Allpass apassR2;
+
+	static std::vector<double> combTimes(double spread) {
+		std::vector<double> times(def_reverbcombs, def_reverbcombs + 4);
+		for(int i = 0; i < 4; i++)
+			times.push_back(def_reverbcombs[i] + spread);
+		return times;
+	}
+
+public:
+	StereoReverb(double decay = 3, double spread = def_stereospread) :
+		decayTime(decay),
+		combs(combTimes(spread), 2),
+		apassL1(0.005), apassL2(0.0017),
+		apassR1(0.005 + spread), apassR2(0.0017 + spread) {
+		combs.setDecay(decayTime);
+		apassL1.setFeedback(apassL1.getFeedbackFromDecay(0.0968));
+		apassL2.setFeedback(apassL2.getFeedbackFromDecay(0.0329));
+		apassR1.setFeedback(apassR1.getFeedbackFromDecay(0.0968));
+		apassR2.setFeedback(apassR2.getFeedbackFromDecay(0.0329));
 	}
 
+	/**
+	 * Output of the last process() call: 0 for left, 1 for right.
+	 */
+	const AudioBuffer &getChannel(int channel) const { return channel == 0 ? apassL2 : apassR2; }
+
 	const AudioBuffer &process(const AudioBuffer &signal) {
-		AudioBuffer parallel;
-		delay1(signal);
-		delay2(signal);
-		delay3(signal);
-		delay4(signal);
-		parallel = delay1 + delay2 + delay3 + delay4;
-		apass1(parallel);
-		fillVector(apass2(apass1));
+		combs(signal);
+		const AudioBuffer &left = apassL2(apassL1(combs.getOutput(0)));
+		const AudioBuffer &right = apassR2(apassR1(combs.getOutput(1)));
+		if(left.isSilent() && right.isSilent()) {
+			setSilence();
+			return *this;
+		}
+		silent = false;
+		for(unsigned int i = 0; i < getVectorSize(); i++)
+			vector[i] = left[i] + right[i];
 		return *this;
 	}
 
@@ -0,0 +1,89 @@
+/*
+ * DenormalBench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Thrifleganger
+ */
+
+/**
+ * Times ToneLP + ButterBP + SReverb on silent input after a burst of sound, once as is and once inside a
+ * DenormalGuard. The tails are left to decay for `def_decaytime` seconds first, long enough for
+ * unflushed feedback state to reach the subnormal range, and `def_benchtime` seconds of silence are then
+ * timed. The silent input is not marked silent, so modules only go idle once their own tails have ended.
+ *
+ * Build it with the library sources: compile it together with every .cpp file of AudioBase, Delay,
+ * Exception, Filter, FunctionTable, Oscillator and Reverb, with each of those directories on the include
+ * path, optimized (-O2), and link libsndfile and PortAudio.
+ */
+
+#include "AudioBase.h"
+#include "Denormal.h"
+#include "Filter.h"
+#include "Oscillator.h"
+#include "Reverb.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+const double def_bursttime = 1.0;
+const double def_decaytime = 300.0;
+const double def_benchtime = 60.0;
+
+/**
+ * The chain under test, built fresh for each run so both start from the same state.
+ */
+struct Chain {
+	ToneLP lowpass;
+	ButterBP bandpass;
+	SReverb reverb;
+
+	Chain() : lowpass(500.0), bandpass(500.0, 100.0), reverb(3.0) {}
+
+	void process(const AudioBuffer &input) {
+		reverb(bandpass(lowpass(input, 500.0), 500.0, 100.0));
+	}
+};
+
+long blocks(double seconds) {
+	return (long)(seconds * AudioParams::getSrate() / AudioParams::getVectorSize());
+}
+
+/**
+ * Runs the burst and the decay, then returns the time in seconds taken by the timed silence.
+ */
+double run() {
+	Chain chain;
+	Oscil burst(0.5, 500.0);
+	AudioBuffer silence;
+
+	for(long b = 0; b < blocks(def_bursttime); b++)
+		chain.process(burst());
+	for(long b = 0; b < blocks(def_decaytime); b++)
+		chain.process(silence);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(long b = 0; b < blocks(def_benchtime); b++)
+		chain.process(silence);
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main() {
+	// Only sets the library parameters; nothing is written to the file.
+	AudioBase audio("denormal_bench.wav", 1);
+
+	double plain = run();
+	double guarded;
+	{
+		DenormalGuard guard;
+		guarded = run();
+	}
+
+	std::cout << "ToneLP + ButterBP + SReverb, " << def_benchtime << " s of silence after "
+			<< def_decaytime << " s of decay" << std::endl;
+	std::cout << "Without DenormalGuard (sec): " << plain << std::endl;
+	std::cout << "With DenormalGuard (sec):    " << guarded << std::endl;
+	return 0;
+}